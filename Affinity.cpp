@@ -0,0 +1,79 @@
+// Conway's Game of Life
+// Copyright (c) 2025 Faraz Fallahi <fffaraz@gmail.com>
+
+#include "Affinity.hpp"
+
+#include <cstdlib>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+bool parseCpuList(const char* text, std::vector<int>& cores)
+{
+    cores.clear();
+    const char* p = text;
+    while (true) {
+        char* end = nullptr;
+        const long first = std::strtol(p, &end, 10);
+        if (end == p || first < 0) {
+            return false;
+        }
+        long last = first;
+        p = end;
+        if (*p == '-') {
+            last = std::strtol(p + 1, &end, 10);
+            if (end == p + 1 || last < first) {
+                return false;
+            }
+            p = end;
+        }
+        constexpr long MAX_CPU = 1 << 16;
+        if (last >= MAX_CPU) {
+            return false;
+        }
+        for (long cpu = first; cpu <= last; ++cpu) {
+            cores.push_back(static_cast<int>(cpu));
+        }
+        if (*p == '\0') {
+            return true;
+        }
+        if (*p++ != ',') {
+            return false;
+        }
+    }
+}
+
+std::string cpuListString(const std::vector<int>& cores)
+{
+    std::string out;
+    for (std::size_t i = 0; i < cores.size();) {
+        std::size_t j = i + 1;
+        while (j < cores.size() && cores[j] == cores[j - 1] + 1) {
+            ++j;
+        }
+        out += (out.empty() ? "" : ",") + std::to_string(cores[i]);
+        if (j - i > 1) {
+            out += "-" + std::to_string(cores[j - 1]);
+        }
+        i = j;
+    }
+    return out;
+}
+
+bool pinCurrentThread(const int cpu)
+{
+#ifdef __linux__
+    if (cpu < 0 || cpu >= CPU_SETSIZE) {
+        return false;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    static_cast<void>(cpu);
+    return false;
+#endif
+}
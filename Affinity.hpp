@@ -0,0 +1,22 @@
+// Conway's Game of Life
+// Copyright (c) 2025 Faraz Fallahi <fffaraz@gmail.com>
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+// Pinning threads to CPU cores. A pinned worker keeps its band's rows in one
+// core's caches, and on a multi-socket machine the pages it first touches stay
+// on its own NUMA node (Linux places a page on the node of the thread that
+// first writes it), so every band reads local memory. Only Linux pins; on other
+// systems pinCurrentThread does nothing and returns false.
+
+// Parse a CPU list such as "0-7,16-23" or "0,2,4" (the format of taskset -c and
+// /sys/devices/system/cpu/online) into core numbers, in the order given.
+bool parseCpuList(const char* text, std::vector<int>& cores);
+// "0-3,8" for {0, 1, 2, 3, 8}.
+std::string cpuListString(const std::vector<int>& cores);
+
+// Pin the calling thread to core `cpu`; false if that is not possible.
+bool pinCurrentThread(int cpu);
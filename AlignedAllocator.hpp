@@ -0,0 +1,50 @@
+// Conway's Game of Life
+// Copyright (c) 2025 Faraz Fallahi <fffaraz@gmail.com>
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <utility>
+
+// std::allocator that hands out ALIGN-byte aligned blocks, so heap-backed grids
+// keep the cache-line alignment the old inline std::array storage had.
+// resize() default-initializes: new words are left unwritten, so their pages
+// are placed on the NUMA node of whichever thread writes them first.
+template <typename T, std::size_t ALIGN = 64>
+class AlignedAllocator {
+public:
+    using value_type = T;
+
+    template <typename U>
+    struct rebind {
+        using other = AlignedAllocator<U, ALIGN>;
+    };
+
+    AlignedAllocator() = default;
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, ALIGN>&) noexcept { }
+
+    T* allocate(std::size_t n)
+    {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t { ALIGN }));
+    }
+    void deallocate(T* p, std::size_t) noexcept
+    {
+        ::operator delete(p, std::align_val_t { ALIGN });
+    }
+
+    template <typename U>
+    void construct(U* p) noexcept
+    {
+        ::new (static_cast<void*>(p)) U;
+    }
+    template <typename U, typename... Args>
+    void construct(U* p, Args&&... args)
+    {
+        ::new (static_cast<void*>(p)) U(std::forward<Args>(args)...);
+    }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, ALIGN>&) const noexcept { return true; }
+};
@@ -3,33 +3,62 @@
 
 #pragma once
 
+#include "Affinity.hpp"
+#include "BandStats.hpp"
+#include "SpinBarrier.hpp"
+
+#include <algorithm>
 #include <atomic>
-#include <barrier>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
 #include <thread>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 // Persistent worker pool: threads stay alive across generations, and each owns a
-// fixed band of work. Two reusable barriers gate the start and end of each pass,
-// so we no longer pay a parallel-for's task dispatch (fork/join) every single
-// generation. Only one coordinator thread may call run() at a time.
+// fixed band of work. One reusable SpinBarrier gates each pass, so we no longer
+// pay a parallel-for's task dispatch (fork/join) every single generation, and
+// its waits spin for `spin` before parking: at 512x512 a generation takes a few
+// microseconds, less than a futex wake-up. run() calls from several threads
+// take turns: each pass has the whole pool to itself, so a thread that must not
+// wait on another's passes (a GUI's render thread) uses a pool of its own.
+// Builds with GOL_BAND_STATS also time each band's work and barrier waits (see
+// BandStats).
+//
+// Given a core list, worker t pins itself to cores[t % cores.size()] before its
+// first pass, so it touches its band's rows first (placing them on its NUMA
+// node) and keeps them there. Band 0 runs on the calling thread, which the pool
+// leaves alone: cores[0] is meant for it, pinned by its owner if wanted.
+//
+// runStealing() is the dynamic alternative for uneven work: finer chunks, each
+// worker starting on its own share and then stealing from the others'.
 class BandExecutor {
 public:
-    explicit BandExecutor(int numThreads)
+    explicit BandExecutor(int numThreads, std::vector<int> cores = {}, std::chrono::nanoseconds spin = {})
         : numThreads_(numThreads > 0 ? numThreads : 1)
-        , start_(numThreads_)
-        , done_(numThreads_)
+        , cores_(std::move(cores))
+        , barrier_(spin)
+        , shares_(std::make_unique<Share[]>(static_cast<std::size_t>(numThreads_)))
+        , profiler_(numThreads_)
     {
         // Band 0 is run by the calling (coordinator) thread; spawn workers for the rest.
         for (int t = 1; t < numThreads_; ++t) {
             workers_.emplace_back([this, t] {
-                while (true) {
-                    start_.arrive_and_wait();
+                if (!cores_.empty()) {
+                    pinCurrentThread(cores_[t % cores_.size()]);
+                }
+                for (uint64_t pass = 0;;) {
+                    pass = barrier_.waitStart(pass);
                     if (stop_.load(std::memory_order_acquire)) {
                         return;
                     }
+                    const auto started = profiler_.started(t);
                     thunk_(ctx_, t);
-                    done_.arrive_and_wait();
+                    profiler_.finished(t, started);
+                    barrier_.done();
                 }
             });
         }
@@ -39,7 +68,7 @@ public:
     {
         if (numThreads_ > 1) {
             stop_.store(true, std::memory_order_release);
-            start_.arrive_and_wait(); // wake parked workers so they observe stop_ and exit
+            barrier_.release(numThreads_ - 1); // wake parked workers so they observe stop_ and exit
         }
         // workers_ (jthreads) join in their destructors.
     }
@@ -48,29 +77,127 @@ public:
     BandExecutor& operator=(const BandExecutor&) = delete;
 
     int size() const { return numThreads_; }
+    // How long the pool's waits spin before parking. Zero parks at once, which
+    // suits more threads than cores: a spinning thread would hold the core the
+    // one it waits for needs.
+    std::chrono::nanoseconds spin() const { return barrier_.spin(); }
+    void setSpin(std::chrono::nanoseconds spin) { barrier_.setSpin(spin); }
+    // The cores the workers are pinned to; empty when unpinned.
+    const std::vector<int>& cores() const { return cores_; }
+
+    // Timings of the passes since the last reset; empty unless GOL_BAND_STATS.
+    BandStats stats() const { return profiler_.stats(); }
+    void resetStats() { profiler_.reset(); }
 
     // Invoke fn(bandIndex) on every band 0..size()-1 and block until all finish.
     // fn stays alive for the whole call, so it is type-erased without allocating.
     template <typename F>
     void run(F&& fn)
+    {
+        const std::lock_guard lock(runMutex_);
+        runLocked(fn);
+    }
+
+    // Invoke fn(t, begin, end) from worker t for chunks [begin, end) covering
+    // 0..count-1, at most `chunk` items each, and block until all are done.
+    // Worker t first works through its own share, the chunks run() would give
+    // band t, front to back; then it steals chunks from the back of the other
+    // shares, so whoever is free finishes an expensive share while its owner
+    // keeps its rows' neighbors. Shares are preallocated cursors: nothing is
+    // allocated per pass. The coordinator sets up every share before releasing
+    // the workers, so the others can steal from a worker slow to wake (or
+    // still parked) as soon as they run out of work, before it gets going.
+    template <typename F>
+    void runStealing(int count, int chunk, F&& fn)
+    {
+        if (numThreads_ == 1) {
+            run([&fn, count](int t) { fn(t, 0, count); });
+            return;
+        }
+        chunk = chunk > 0 ? chunk : 1;
+        const int chunks = (count + chunk - 1) / chunk;
+        const int n = numThreads_;
+        const std::lock_guard lock(runMutex_);
+        // A share is [front, back) of chunk indexes, packed in one word so its
+        // owner and thieves claim chunks with one compare-and-swap. The pass's
+        // release publishes them.
+        for (int t = 0; t < n; ++t) {
+            const auto first = static_cast<uint64_t>(static_cast<long long>(t) * chunks / n);
+            const auto last = static_cast<uint64_t>(static_cast<long long>(t + 1) * chunks / n);
+            shares_[t].range.store(first | (last << 32), std::memory_order_relaxed);
+        }
+        auto pass = [this, &fn, count, chunk, n](int t) {
+            const auto runChunk = [&](uint64_t c) {
+                const int begin = static_cast<int>(c) * chunk;
+                fn(t, begin, std::min(count, begin + chunk));
+            };
+            for (uint64_t c; claim(shares_[t].range, true, c);) {
+                runChunk(c);
+            }
+            for (int v = 1; v < n; ++v) {
+                std::atomic<uint64_t>& victim = shares_[(t + v) % n].range;
+                for (uint64_t c; claim(victim, false, c);) {
+                    runChunk(c);
+                }
+            }
+        };
+        runLocked(pass);
+    }
+
+private:
+    // run() once runMutex_ is held.
+    template <typename F>
+    void runLocked(F& fn)
     {
         ctx_ = &fn;
         thunk_ = [](void* p, int t) { (*static_cast<std::remove_reference_t<F>*>(p))(t); };
+        const auto begun = BandProfiler::now();
+        profiler_.released(begun);
         if (numThreads_ == 1) {
+            const auto started = profiler_.started(0);
             thunk_(ctx_, 0);
+            profiler_.finished(0, started);
+            profiler_.passDone(begun);
             return;
         }
-        start_.arrive_and_wait(); // release workers; they now observe ctx_/thunk_
+        barrier_.release(numThreads_ - 1); // release workers; they now observe ctx_/thunk_
+        const auto started = profiler_.started(0);
         thunk_(ctx_, 0); // coordinator runs band 0
-        done_.arrive_and_wait(); // wait for all workers to finish this pass
+        profiler_.finished(0, started);
+        barrier_.waitDone(); // wait for all workers to finish this pass
+        profiler_.passDone(begun);
+    }
+
+    struct alignas(64) Share {
+        std::atomic<uint64_t> range { 0 }; // front | back << 32
+    };
+
+    // Take the front (owner) or back (thief) chunk of a share; false once empty.
+    static bool claim(std::atomic<uint64_t>& range, bool front, uint64_t& chunk)
+    {
+        uint64_t r = range.load(std::memory_order_acquire);
+        while (true) {
+            const uint64_t lo = r & 0xffffffffULL;
+            const uint64_t hi = r >> 32;
+            if (lo >= hi) {
+                return false;
+            }
+            const uint64_t next = front ? (lo + 1) | (hi << 32) : lo | ((hi - 1) << 32);
+            if (range.compare_exchange_weak(r, next, std::memory_order_acq_rel, std::memory_order_acquire)) {
+                chunk = front ? lo : hi - 1;
+                return true;
+            }
+        }
     }
 
-private:
     const int numThreads_;
+    const std::vector<int> cores_;
+    std::mutex runMutex_;
     std::atomic<bool> stop_ { false };
     void* ctx_ = nullptr;
     void (*thunk_)(void*, int) = nullptr;
-    std::barrier<> start_;
-    std::barrier<> done_;
+    SpinBarrier barrier_;
+    std::unique_ptr<Share[]> shares_;
+    BandProfiler profiler_;
     std::vector<std::jthread> workers_;
 };
@@ -0,0 +1,164 @@
+// Conway's Game of Life
+// Copyright (c) 2025 Faraz Fallahi <fffaraz@gmail.com>
+
+#include "BandStats.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdio>
+
+int TimeHistogram::bucketOf(const uint64_t ns)
+{
+    if (ns < SUB_BUCKETS) {
+        return static_cast<int>(ns);
+    }
+    // The top bit picks the power of two, the next two bits the quarter of it.
+    const int top = std::bit_width(ns) - 1;
+    const int quarter = static_cast<int>((ns >> (top - 2)) & 3);
+    return std::min((SUB_BUCKETS * (top - 1)) + quarter, BUCKETS - 1);
+}
+
+uint64_t TimeHistogram::bucketMaxNs(const int bucket)
+{
+    if (bucket < SUB_BUCKETS) {
+        return static_cast<uint64_t>(bucket);
+    }
+    const int top = (bucket / SUB_BUCKETS) + 1;
+    const uint64_t quarter = uint64_t { 1 } << (top - 2);
+    return ((SUB_BUCKETS + static_cast<uint64_t>(bucket % SUB_BUCKETS) + 1) * quarter) - 1;
+}
+
+void TimeHistogram::add(const uint64_t ns)
+{
+    ++counts[bucketOf(ns)];
+    ++samples;
+    totalNs += ns;
+    maxNs = std::max(maxNs, ns);
+}
+
+void TimeHistogram::merge(const TimeHistogram& other)
+{
+    for (int b = 0; b < BUCKETS; ++b) {
+        counts[b] += other.counts[b];
+    }
+    samples += other.samples;
+    totalNs += other.totalNs;
+    maxNs = std::max(maxNs, other.maxNs);
+}
+
+uint64_t TimeHistogram::percentileNs(const double p) const
+{
+    if (samples == 0) {
+        return 0;
+    }
+    const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(p / 100 * static_cast<double>(samples))));
+    uint64_t seen = 0;
+    for (int b = 0; b < BUCKETS; ++b) {
+        seen += counts[b];
+        if (seen >= rank) {
+            return std::min(bucketMaxNs(b), maxNs);
+        }
+    }
+    return maxNs;
+}
+
+namespace {
+
+void appendRow(std::string& out, const char* name, const TimeHistogram& h)
+{
+    char line[160];
+    std::snprintf(line, sizeof(line), "  %-16s %10.1f %10.1f %10.1f %10.1f\n", name, h.meanNs() / 1e3, static_cast<double>(h.percentileNs(50)) / 1e3,
+        static_cast<double>(h.percentileNs(99)) / 1e3, static_cast<double>(h.maxNs) / 1e3);
+    out += line;
+}
+
+} // namespace
+
+std::string formatBandStats(const BandStats& stats)
+{
+    if (stats.pass.samples == 0) {
+        return BAND_STATS_ENABLED ? "  (no passes)\n" : "  (not collected: build with GOL_BAND_STATS=ON)\n";
+    }
+    std::string out = "  " + std::to_string(stats.pass.samples) + " passes on " + std::to_string(stats.work.size()) + " bands, in microseconds:\n";
+    out += "                         mean     median        p99        max\n";
+    appendRow(out, "pass", stats.pass);
+    appendRow(out, "imbalance", stats.imbalance);
+    for (std::size_t b = 0; b < stats.work.size(); ++b) {
+        const std::string band = "band " + std::to_string(b);
+        appendRow(out, (band + " work").c_str(), stats.work[b]);
+        appendRow(out, (band + " start").c_str(), stats.startLatency[b]);
+        appendRow(out, (band + " wait").c_str(), stats.doneWait[b]);
+    }
+    out += bandStatsSummary(stats) + "\n";
+    return out;
+}
+
+std::string bandStatsSummary(const BandStats& stats)
+{
+    if (stats.pass.samples == 0) {
+        return {};
+    }
+    // Shares of the bands' total pass time: working, and waiting at the end.
+    uint64_t work = 0;
+    uint64_t wait = 0;
+    for (std::size_t b = 0; b < stats.work.size(); ++b) {
+        work += stats.work[b].totalNs;
+        wait += stats.doneWait[b].totalNs;
+    }
+    const double total = static_cast<double>(stats.pass.totalNs) * static_cast<double>(stats.work.size());
+    char line[120];
+    std::snprintf(line, sizeof(line), "  Work %.0f%%, end wait %.0f%%, imbalance %.1f us (p99 %.1f us)", 100 * static_cast<double>(work) / total,
+        100 * static_cast<double>(wait) / total, stats.imbalance.meanNs() / 1e3, static_cast<double>(stats.imbalance.percentileNs(99)) / 1e3);
+    return line;
+}
+
+#if GOL_BAND_STATS
+
+TimeHistogram BandProfiler::Histogram::snapshot() const
+{
+    TimeHistogram h;
+    for (int b = 0; b < TimeHistogram::BUCKETS; ++b) {
+        h.counts[b] = counts[b].load(std::memory_order_relaxed);
+    }
+    h.samples = samples.load(std::memory_order_relaxed);
+    h.totalNs = totalNs.load(std::memory_order_relaxed);
+    h.maxNs = maxNs.load(std::memory_order_relaxed);
+    return h;
+}
+
+void BandProfiler::Histogram::reset()
+{
+    for (auto& c : counts) {
+        c.store(0, std::memory_order_relaxed);
+    }
+    samples.store(0, std::memory_order_relaxed);
+    totalNs.store(0, std::memory_order_relaxed);
+    maxNs.store(0, std::memory_order_relaxed);
+}
+
+BandStats BandProfiler::stats() const
+{
+    BandStats s;
+    for (int b = 0; b < bands_; ++b) {
+        s.work.push_back(slots_[b].work.snapshot());
+        s.startLatency.push_back(slots_[b].startLatency.snapshot());
+        s.doneWait.push_back(slots_[b].doneWait.snapshot());
+    }
+    s.pass = pass_.snapshot();
+    s.imbalance = imbalance_.snapshot();
+    return s;
+}
+
+void BandProfiler::reset()
+{
+    for (int b = 0; b < bands_; ++b) {
+        slots_[b].work.reset();
+        slots_[b].startLatency.reset();
+        slots_[b].doneWait.reset();
+    }
+    pass_.reset();
+    imbalance_.reset();
+}
+
+#endif
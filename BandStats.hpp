@@ -0,0 +1,186 @@
+// Conway's Game of Life
+// Copyright (c) 2025 Faraz Fallahi <fffaraz@gmail.com>
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Where BandExecutor passes spend their time, for telling slow kernels from
+// barrier latency and band imbalance. Only collected in builds with
+// GOL_BAND_STATS=1 (the CMake option of the same name); otherwise the profiler
+// below is empty inline functions and the executor compiles to what it was.
+#ifndef GOL_BAND_STATS
+#define GOL_BAND_STATS 0
+#endif
+
+inline constexpr bool BAND_STATS_ENABLED = GOL_BAND_STATS != 0;
+
+// Durations in nanoseconds, bucketed by powers of two split four ways, so a
+// percentile is known to within 25%.
+struct TimeHistogram {
+    static constexpr int SUB_BUCKETS = 4;
+    static constexpr int BUCKETS = 40 * SUB_BUCKETS; // up to about 18 minutes
+
+    std::array<uint64_t, BUCKETS> counts {};
+    uint64_t samples = 0;
+    uint64_t totalNs = 0;
+    uint64_t maxNs = 0;
+
+    static int bucketOf(uint64_t ns);
+    // The largest duration in bucket.
+    static uint64_t bucketMaxNs(int bucket);
+
+    void add(uint64_t ns);
+    void merge(const TimeHistogram& other);
+    double meanNs() const { return samples == 0 ? 0 : static_cast<double>(totalNs) / static_cast<double>(samples); }
+    // Upper bound of the p-th percentile (0..100), at most maxNs.
+    uint64_t percentileNs(double p) const;
+};
+
+// Timings of the passes run since the last reset, per band: its work (the
+// pass's function), its start latency (from run() releasing the pool until the
+// band starts) and its wait at the end of the pass, from finishing its work
+// until the slowest band is done too: time its core sat idle in that pass,
+// whether it was band 0 (the calling thread) waiting on the others or a worker
+// gone back to wait for the next pass. Per pass: run()'s wall time and the
+// imbalance, the slowest band's work minus the fastest's.
+struct BandStats {
+    std::vector<TimeHistogram> work;
+    std::vector<TimeHistogram> startLatency;
+    std::vector<TimeHistogram> doneWait;
+    TimeHistogram pass;
+    TimeHistogram imbalance;
+};
+
+// A table of the above, for the CLI.
+std::string formatBandStats(const BandStats& stats);
+// One line (work share of the bands' time, barrier wait, imbalance), for a GUI
+// overlay; empty without passes.
+std::string bandStatsSummary(const BandStats& stats);
+
+#if GOL_BAND_STATS
+
+// Collects BandStats as BandExecutor runs. Each band's work and start
+// histograms are written only by the thread running it, its end waits only by
+// the coordinator once the pass is over, and all are read (stats()) from any
+// thread, so they are relaxed atomics, each band's on its own cache lines.
+class BandProfiler {
+public:
+    using Stamp = std::chrono::steady_clock::time_point;
+
+    explicit BandProfiler(int bands)
+        : bands_(bands)
+        , slots_(std::make_unique<Slot[]>(static_cast<std::size_t>(bands)))
+    {
+    }
+
+    static Stamp now() { return std::chrono::steady_clock::now(); }
+
+    // Coordinator, as it releases the pool.
+    void released(Stamp at) { released_.store(at.time_since_epoch().count(), std::memory_order_relaxed); }
+    // A band starting and finishing its work.
+    Stamp started(int band)
+    {
+        const Stamp t = now();
+        slots_[band].startLatency.add(nanoseconds(t.time_since_epoch().count() - released_.load(std::memory_order_relaxed)));
+        return t;
+    }
+    Stamp finished(int band, Stamp started)
+    {
+        const Stamp t = now();
+        const uint64_t work = nanoseconds(t - started);
+        slots_[band].work.add(work);
+        slots_[band].lastWork.store(work, std::memory_order_relaxed);
+        slots_[band].lastFinish.store(t.time_since_epoch().count(), std::memory_order_relaxed);
+        return t;
+    }
+    // Coordinator, once every band is done: their lastWork and lastFinish are
+    // this pass's, and each band waited from its finish until now.
+    void passDone(Stamp begun)
+    {
+        const Stamp end = now();
+        uint64_t slowest = 0;
+        uint64_t fastest = UINT64_MAX;
+        for (int b = 0; b < bands_; ++b) {
+            const uint64_t work = slots_[b].lastWork.load(std::memory_order_relaxed);
+            slowest = std::max(slowest, work);
+            fastest = std::min(fastest, work);
+            slots_[b].doneWait.add(nanoseconds(end.time_since_epoch().count() - slots_[b].lastFinish.load(std::memory_order_relaxed)));
+        }
+        pass_.add(nanoseconds(end - begun));
+        imbalance_.add(slowest - fastest);
+    }
+
+    BandStats stats() const;
+    void reset();
+
+private:
+    struct Histogram {
+        std::array<std::atomic<uint64_t>, TimeHistogram::BUCKETS> counts {};
+        std::atomic<uint64_t> samples { 0 };
+        std::atomic<uint64_t> totalNs { 0 };
+        std::atomic<uint64_t> maxNs { 0 };
+
+        // One writer: plain load/store pairs, no read-modify-write.
+        void add(uint64_t ns)
+        {
+            bump(counts[TimeHistogram::bucketOf(ns)], 1);
+            bump(samples, 1);
+            bump(totalNs, ns);
+            if (ns > maxNs.load(std::memory_order_relaxed)) {
+                maxNs.store(ns, std::memory_order_relaxed);
+            }
+        }
+        TimeHistogram snapshot() const;
+        void reset();
+
+        static void bump(std::atomic<uint64_t>& a, uint64_t by) { a.store(a.load(std::memory_order_relaxed) + by, std::memory_order_relaxed); }
+    };
+    struct alignas(64) Slot {
+        Histogram work;
+        Histogram startLatency;
+        Histogram doneWait;
+        std::atomic<uint64_t> lastWork { 0 };
+        std::atomic<std::chrono::steady_clock::rep> lastFinish { 0 };
+    };
+
+    static uint64_t nanoseconds(std::chrono::steady_clock::duration d) { return nanoseconds(d.count()); }
+    static uint64_t nanoseconds(std::chrono::steady_clock::rep ticks)
+    {
+        return ticks <= 0 ? 0 : static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::duration(ticks)).count());
+    }
+
+    const int bands_;
+    std::unique_ptr<Slot[]> slots_;
+    std::atomic<std::chrono::steady_clock::rep> released_ { 0 };
+    Histogram pass_; // coordinator only
+    Histogram imbalance_;
+};
+
+#else
+
+// Disabled: nothing to store, nothing to time.
+class BandProfiler {
+public:
+    struct Stamp { };
+
+    explicit BandProfiler(int) { }
+
+    static Stamp now() { return {}; }
+    void released(Stamp) { }
+    Stamp started(int) { return {}; }
+    Stamp finished(int, Stamp) { return {}; }
+    void passDone(Stamp) { }
+
+    BandStats stats() const { return {}; }
+    void reset() { }
+};
+
+#endif
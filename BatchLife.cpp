@@ -0,0 +1,261 @@
+// Conway's Game of Life
+// Copyright (c) 2025 Faraz Fallahi <fffaraz@gmail.com>
+
+#include "BatchLife.hpp"
+#include "BandExecutor.hpp"
+#include "Random.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+
+// Sum of eight lane-wise bits as four bit-planes (ones, twos, fours, eights),
+// through full adders: each lane counts its own cell's neighbors.
+struct Count {
+    uint64_t p0, p1, p2, p3;
+};
+
+inline void fullAdd(const uint64_t a, const uint64_t b, const uint64_t c, uint64_t& sum, uint64_t& carry)
+{
+    const uint64_t ab = a ^ b;
+    sum = ab ^ c;
+    carry = (a & b) | (c & ab);
+}
+
+inline Count countNeighbors(uint64_t a, uint64_t b, uint64_t c, uint64_t d, uint64_t e, uint64_t f, uint64_t g, uint64_t h)
+{
+    uint64_t s1, c1, s2, c2, s4, c4, s5, c5;
+    fullAdd(a, b, c, s1, c1);
+    fullAdd(d, e, f, s2, c2);
+    const uint64_t s3 = g ^ h;
+    const uint64_t c3 = g & h;
+    fullAdd(s1, s2, s3, s4, c4);
+    // Four carries of weight two.
+    fullAdd(c1, c2, c3, s5, c5);
+    const uint64_t c6 = s5 & c4;
+    return { s4, s5 ^ c4, c5 ^ c6, c5 & c6 };
+}
+
+} // namespace
+
+BatchLife::BatchLife(int width, int height, int universes)
+    : width_(width)
+    , height_(height)
+    , universes_(universes)
+    , groups_((universes + LANES - 1) / LANES)
+{
+    if (width <= 0 || height <= 0 || universes <= 0) {
+        throw std::invalid_argument("batch dimensions and universe count must be positive");
+    }
+    words_.assign(cells() * groups_, 0);
+    setThreads(0);
+}
+
+BatchLife::~BatchLife() = default;
+
+int BatchLife::threads() const
+{
+    return exec_->size();
+}
+
+void BatchLife::setThreads(int threads)
+{
+    if (threads <= 0) {
+        threads = std::min(groups_, static_cast<int>(std::max(1u, std::thread::hardware_concurrency())));
+    }
+    if (!exec_ || exec_->size() != threads) {
+        exec_ = std::make_unique<BandExecutor>(threads, workerCores(), barrierSpin());
+    }
+}
+
+void BatchLife::load(const int universe, const DynamicGrid& grid)
+{
+    for (int x = 0; x < height_; ++x) {
+        for (int y = 0; y < width_; ++y) {
+            set(universe, { x, y }, grid.get({ x, y }));
+        }
+    }
+}
+
+void BatchLife::store(const int universe, DynamicGrid& grid) const
+{
+    grid.clear();
+    for (int x = 0; x < height_; ++x) {
+        uint64_t* const row = grid.rowForEdit(x);
+        for (int y = 0; y < width_; ++y) {
+            row[y >> 6] |= static_cast<uint64_t>(get(universe, { x, y })) << (y & 63);
+        }
+    }
+    grid.endEdits();
+}
+
+// Counter-based like DynamicGrid::randomize, a group per task: word i is
+// randomWord i of the seed's stream whichever worker fills it.
+void BatchLife::randomize(const double density, const uint64_t seed)
+{
+    const uint32_t threshold = densityThreshold(density);
+    exec_->runStealing(groups_, 1, [this, threshold, seed](int, int begin, int end) {
+        for (int g = begin; g < end; ++g) {
+            const std::size_t first = static_cast<std::size_t>(g) * cells();
+            // Lanes past the last universe start empty.
+            const int used = std::min(LANES, universes_ - (g * LANES));
+            const uint64_t mask = used == LANES ? ~0ULL : (1ULL << used) - 1;
+            for (std::size_t i = first; i < first + cells(); ++i) {
+                words_[i] = randomWord(seed, i, threshold) & mask;
+            }
+        }
+    });
+}
+
+void BatchLife::clear()
+{
+    std::fill(words_.begin(), words_.end(), 0ULL);
+}
+
+void BatchLife::step(const int generations)
+{
+    if (generations <= 0) {
+        return;
+    }
+    // Groups are independent: each goes all the way on one worker.
+    exec_->runStealing(groups_, 1, [this, generations](int, int begin, int end) {
+        for (int g = begin; g < end; ++g) {
+            stepGroup(words_.data() + (static_cast<std::size_t>(g) * cells()), generations);
+        }
+    });
+}
+
+// Ping-pong with a per-thread scratch copy; an odd count copies the result back.
+void BatchLife::stepGroup(uint64_t* const cells, const int generations) const
+{
+    thread_local std::vector<uint64_t> scratch;
+    scratch.resize(this->cells());
+    uint64_t* src = cells;
+    uint64_t* dst = scratch.data();
+    for (int g = 0; g < generations; ++g) {
+        stepCells(src, dst);
+        std::swap(src, dst);
+    }
+    if (src != cells) {
+        std::copy_n(src, this->cells(), cells);
+    }
+}
+
+void BatchLife::stepCells(const uint64_t* const src, uint64_t* const dst) const
+{
+    const int w = width_;
+    const int h = height_;
+    // Rows padded with one cell each side, filled per the boundary mode.
+    thread_local std::vector<uint64_t> padded;
+    padded.resize(3 * static_cast<std::size_t>(w + 2));
+    uint64_t* rows[3] = { padded.data(), padded.data() + (w + 2), padded.data() + (2 * (w + 2)) };
+    const auto pad = [&](int x, uint64_t* out) {
+        if (x < 0 || x >= h) {
+            switch (boundary_) {
+            case Boundary::Torus:
+                x = (x + h) % h;
+                break;
+            case Boundary::Reflect:
+                x = std::clamp(x, 0, h - 1);
+                break;
+            default:
+                std::fill_n(out, w + 2, boundary_ == Boundary::Alive ? ~0ULL : 0ULL);
+                return;
+            }
+        }
+        const uint64_t* const row = src + (static_cast<std::size_t>(x) * w);
+        std::copy_n(row, w, out + 1);
+        switch (boundary_) {
+        case Boundary::Torus:
+            out[0] = row[w - 1];
+            out[w + 1] = row[0];
+            break;
+        case Boundary::Reflect:
+            out[0] = row[0];
+            out[w + 1] = row[w - 1];
+            break;
+        default:
+            out[0] = out[w + 1] = boundary_ == Boundary::Alive ? ~0ULL : 0ULL;
+        }
+    };
+
+    // The neighbor counts the rule cares about, and for each whether a dead
+    // cell is born and a live one survives.
+    struct Outcome {
+        int count;
+        uint64_t born;
+        uint64_t survives;
+    };
+    Outcome outcomes[9];
+    int used = 0;
+    for (int n = 0; n <= 8; ++n) {
+        const bool born = ((rule_.birth >> n) & 1) != 0;
+        const bool survives = ((rule_.survive >> n) & 1) != 0;
+        if (born || survives) {
+            outcomes[used++] = { n, born ? ~0ULL : 0, survives ? ~0ULL : 0 };
+        }
+    }
+
+    // Per row, two passes the compiler can vectorize: the neighbor counts of
+    // every column, then each outcome over the whole row.
+    thread_local std::vector<uint64_t> planes;
+    planes.resize(4 * static_cast<std::size_t>(w));
+    uint64_t* const p0 = planes.data();
+    uint64_t* const p1 = p0 + w;
+    uint64_t* const p2 = p1 + w;
+    uint64_t* const p3 = p2 + w;
+
+    pad(-1, rows[0]);
+    pad(0, rows[1]);
+    for (int x = 0; x < h; ++x) {
+        pad(x + 1, rows[2]);
+        const uint64_t* const top = rows[0];
+        const uint64_t* const mid = rows[1];
+        const uint64_t* const bot = rows[2];
+        for (int y = 0; y < w; ++y) {
+            const Count c = countNeighbors(top[y], top[y + 1], top[y + 2], mid[y], mid[y + 2], bot[y], bot[y + 1], bot[y + 2]);
+            p0[y] = c.p0;
+            p1[y] = c.p1;
+            p2[y] = c.p2;
+            p3[y] = c.p3;
+        }
+        uint64_t* const out = dst + (static_cast<std::size_t>(x) * w);
+        std::fill_n(out, w, 0ULL);
+        for (int i = 0; i < used; ++i) {
+            const int n = outcomes[i].count;
+            const uint64_t f0 = (n & 1) ? 0 : ~0ULL;
+            const uint64_t f1 = (n & 2) ? 0 : ~0ULL;
+            const uint64_t f2 = (n & 4) ? 0 : ~0ULL;
+            const uint64_t f3 = (n & 8) ? 0 : ~0ULL;
+            const uint64_t born = outcomes[i].born;
+            const uint64_t survives = outcomes[i].survives;
+            for (int y = 0; y < w; ++y) {
+                const uint64_t self = mid[y + 1];
+                const uint64_t match = (p0[y] ^ f0) & (p1[y] ^ f1) & (p2[y] ^ f2) & (p3[y] ^ f3);
+                out[y] |= match & ((born & ~self) | (survives & self));
+            }
+        }
+        std::rotate(rows, rows + 1, rows + 3);
+    }
+}
+
+std::vector<long long> BatchLife::populations() const
+{
+    std::vector<long long> counts(universes_, 0);
+    for (int g = 0; g < groups_; ++g) {
+        const uint64_t* const cells = words_.data() + (static_cast<std::size_t>(g) * this->cells());
+        long long* const lanes = counts.data() + (static_cast<std::size_t>(g) * LANES);
+        // The last group's spare lanes evolve too (an alive boundary fills them).
+        const int used = std::min(LANES, universes_ - (g * LANES));
+        const uint64_t mask = used == LANES ? ~0ULL : (1ULL << used) - 1;
+        for (std::size_t i = 0; i < this->cells(); ++i) {
+            for (uint64_t w = cells[i] & mask; w != 0; w &= w - 1) {
+                ++lanes[std::countr_zero(w)];
+            }
+        }
+    }
+    return counts;
+}
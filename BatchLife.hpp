@@ -0,0 +1,87 @@
+// Conway's Game of Life
+// Copyright (c) 2025 Faraz Fallahi <fffaraz@gmail.com>
+
+#pragma once
+
+#include "Grid.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Many independent small universes stepped together, for parameter sweeps over
+// thousands of soups. The universes are bit-sliced: each 64-bit word holds one
+// cell of 64 universes (a lane each), so one pass of the bitwise adder network
+// advances all 64 at once, whatever the grid size, and a 64x64 universe costs
+// no per-grid setup or barrier. Lanes of 64 universes form groups; a step hands
+// whole groups to the worker threads, each advancing its groups every
+// generation asked for before the single sync at the end.
+//
+// All universes share the size, boundary mode and rule; a cell reads and
+// writes like DynamicGrid's, (x, y) being row x, column y.
+class BatchLife {
+public:
+    static constexpr int LANES = 64;
+
+    // Throws std::invalid_argument unless all three are positive.
+    BatchLife(int width, int height, int universes);
+    ~BatchLife();
+    BatchLife(const BatchLife&) = delete;
+    BatchLife& operator=(const BatchLife&) = delete;
+
+    int width() const { return width_; }
+    int height() const { return height_; }
+    int universes() const { return universes_; }
+
+    Boundary boundary() const { return boundary_; }
+    void setBoundary(Boundary boundary) { boundary_ = boundary; }
+    const Rule& rule() const { return rule_; }
+    void setRule(const Rule& rule) { rule_ = rule; }
+    // Worker threads for step(); 0 (the default) for one per group, up to the
+    // hardware threads.
+    int threads() const;
+    void setThreads(int threads);
+
+    bool get(int universe, const Point& p) const
+    {
+        return (words_[index(universe, p)] >> lane(universe)) & 1ULL;
+    }
+    void set(int universe, const Point& p, bool value)
+    {
+        uint64_t& w = words_[index(universe, p)];
+        w = value ? (w | (1ULL << lane(universe))) : (w & ~(1ULL << lane(universe)));
+    }
+    // Copy a universe from or to a grid of the same size (its cells only).
+    void load(int universe, const DynamicGrid& grid);
+    void store(int universe, DynamicGrid& grid) const;
+    // Every universe a different soup: each cell alive with probability
+    // `density` (to 1/65536), the same for the same seed at any thread count.
+    void randomize(double density, uint64_t seed);
+    void clear();
+
+    // Advance every universe `generations` generations.
+    void step(int generations = 1);
+    // Live cells of each universe.
+    std::vector<long long> populations() const;
+
+private:
+    static int lane(int universe) { return universe % LANES; }
+    // Each group's cells are contiguous, row after row, so a worker steps a
+    // group within its own cache.
+    std::size_t cells() const { return static_cast<std::size_t>(width_) * height_; }
+    std::size_t index(int universe, const Point& p) const
+    {
+        return (static_cast<std::size_t>(universe / LANES) * cells()) + (static_cast<std::size_t>(p.x) * width_) + p.y;
+    }
+    void stepGroup(uint64_t* cells, int generations) const;
+    void stepCells(const uint64_t* src, uint64_t* dst) const;
+
+    int width_;
+    int height_;
+    int universes_;
+    int groups_;
+    Boundary boundary_ = Boundary::Dead;
+    Rule rule_;
+    std::vector<uint64_t> words_;
+    std::unique_ptr<BandExecutor> exec_;
+};
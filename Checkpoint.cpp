@@ -0,0 +1,260 @@
+// Conway's Game of Life
+// Copyright (c) 2025 Faraz Fallahi <fffaraz@gmail.com>
+
+#include "Checkpoint.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <system_error>
+
+#ifdef _WIN32
+#include <vector>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+constexpr std::array<char, 8> MAGIC { 'G', 'O', 'L', 'C', 'K', 'P', 'T', '\n' };
+constexpr uint32_t VERSION = 1;
+constexpr uint32_t BYTE_ORDER_MARK = 0x01020304; // reads back differently on a host of the other endianness
+// The words start here, on a page boundary of the mapped file.
+constexpr std::size_t DATA_OFFSET = 4096;
+
+struct Header {
+    std::array<char, 8> magic;
+    uint32_t version;
+    uint32_t byteOrder;
+    int32_t width;
+    int32_t height;
+    int32_t wordsPerRow;
+    uint32_t boundary;
+    uint16_t birth;
+    uint16_t survive;
+    uint32_t reserved;
+    uint64_t generation;
+};
+static_assert(sizeof(Header) <= DATA_OFFSET);
+
+[[noreturn]] void fail(const std::string& path, const std::string& what)
+{
+    throw std::runtime_error(path + ": " + what);
+}
+
+std::size_t dataBytes(int height, int wordsPerRow)
+{
+    return static_cast<std::size_t>(height) * static_cast<std::size_t>(wordsPerRow) * sizeof(uint64_t);
+}
+
+// Validate a header read from a fileSize-byte file.
+CheckpointInfo parseHeader(const Header& h, uint64_t fileSize, const std::string& path)
+{
+    if (fileSize < DATA_OFFSET || h.magic != MAGIC) {
+        fail(path, "not a checkpoint");
+    }
+    if (h.byteOrder != BYTE_ORDER_MARK) {
+        fail(path, "checkpoint from a host of the other byte order");
+    }
+    if (h.version != VERSION) {
+        fail(path, "unsupported checkpoint version " + std::to_string(h.version));
+    }
+    if (h.width <= 0 || h.height <= 0 || h.wordsPerRow != (h.width + 63) / 64 || h.boundary > static_cast<uint32_t>(Boundary::Alive)) {
+        fail(path, "corrupt checkpoint header");
+    }
+    if (fileSize != DATA_OFFSET + dataBytes(h.height, h.wordsPerRow)) {
+        fail(path, "truncated checkpoint");
+    }
+    CheckpointInfo info;
+    info.width = h.width;
+    info.height = h.height;
+    info.boundary = static_cast<Boundary>(h.boundary);
+    info.rule = Rule { h.birth, h.survive };
+    info.generation = h.generation;
+    return info;
+}
+
+// The whole file, read-only: mapped where mmap exists, else read in one go.
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path)
+    {
+#ifdef _WIN32
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        if (!in) {
+            fail(path, "cannot open");
+        }
+        buffer_.resize(static_cast<std::size_t>(in.tellg()));
+        in.seekg(0);
+        if (!in.read(buffer_.data(), static_cast<std::streamsize>(buffer_.size()))) {
+            fail(path, "error reading checkpoint");
+        }
+        data_ = buffer_.data();
+        size_ = buffer_.size();
+#else
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            fail(path, "cannot open");
+        }
+        struct stat st {};
+        if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+            size_ = static_cast<std::size_t>(st.st_size);
+            int flags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+            flags |= MAP_POPULATE; // fault the pages in with one big readahead
+#endif
+            void* const p = ::mmap(nullptr, size_, PROT_READ, flags, fd, 0);
+            data_ = p == MAP_FAILED ? nullptr : static_cast<const char*>(p);
+        }
+        ::close(fd);
+        if (data_ == nullptr) {
+            fail(path, "cannot map");
+        }
+#endif
+    }
+    ~MappedFile()
+    {
+#ifndef _WIN32
+        ::munmap(const_cast<char*>(data_), size_);
+#endif
+    }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const { return data_; }
+    std::size_t size() const { return size_; }
+
+private:
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+#ifdef _WIN32
+    std::vector<char> buffer_;
+#endif
+};
+
+// Write the header page and the words to path.
+void writeFile(const std::string& path, const char* page, const char* words, std::size_t bytes)
+{
+#ifdef _WIN32
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(page, DATA_OFFSET);
+    out.write(words, static_cast<std::streamsize>(bytes));
+    out.flush();
+    if (!out) {
+        fail(path, "error writing checkpoint");
+    }
+#else
+    const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        fail(path, "cannot create");
+    }
+    iovec parts[2] = { { const_cast<char*>(page), DATA_OFFSET }, { const_cast<char*>(words), bytes } };
+    iovec* iov = parts;
+    int count = 2;
+    // writev may stop short (Linux writes at most 2 GiB per call): carry on from there.
+    while (count > 0) {
+        const ssize_t n = ::writev(fd, iov, count);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            ::close(fd);
+            fail(path, "error writing checkpoint");
+        }
+        std::size_t done = static_cast<std::size_t>(n);
+        while (count > 0 && done >= iov->iov_len) {
+            done -= iov->iov_len;
+            ++iov;
+            --count;
+        }
+        if (count > 0) {
+            iov->iov_base = static_cast<char*>(iov->iov_base) + done;
+            iov->iov_len -= done;
+        }
+    }
+    // The data must be on disk before the rename makes it the checkpoint.
+    const bool synced = ::fsync(fd) == 0;
+    if (::close(fd) != 0 || !synced) {
+        fail(path, "error writing checkpoint");
+    }
+#endif
+}
+
+} // namespace
+
+void saveCheckpoint(const std::string& path, const DynamicGrid& grid, const uint64_t generation)
+{
+    Header h {};
+    h.magic = MAGIC;
+    h.version = VERSION;
+    h.byteOrder = BYTE_ORDER_MARK;
+    h.width = grid.width();
+    h.height = grid.height();
+    h.wordsPerRow = grid.wordsPerRow();
+    h.boundary = static_cast<uint32_t>(grid.boundary());
+    h.birth = grid.rule().birth;
+    h.survive = grid.rule().survive;
+    h.generation = generation;
+    std::array<char, DATA_OFFSET> page {};
+    std::memcpy(page.data(), &h, sizeof(h));
+
+    // Rows are contiguous, so the words go out in one piece.
+    const std::string temporary = path + ".tmp";
+    writeFile(temporary, page.data(), reinterpret_cast<const char*>(grid.row(0)), dataBytes(h.height, h.wordsPerRow));
+    std::error_code error;
+    std::filesystem::rename(temporary, path, error);
+    if (error) {
+        fail(path, "cannot replace: " + error.message());
+    }
+}
+
+CheckpointInfo readCheckpointInfo(const std::string& path)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        fail(path, "cannot open");
+    }
+    Header h {};
+    in.read(reinterpret_cast<char*>(&h), sizeof(h));
+    std::error_code error;
+    const uint64_t size = std::filesystem::file_size(path, error);
+    return parseHeader(h, in ? size : 0, path);
+}
+
+CheckpointInfo loadCheckpoint(const std::string& path, DynamicGrid& grid)
+{
+    const MappedFile file(path);
+    Header h {};
+    std::memcpy(&h, file.data(), std::min(sizeof(h), file.size()));
+    const CheckpointInfo info = parseHeader(h, file.size(), path);
+    if (info.width != grid.width() || info.height != grid.height()) {
+        fail(path, "checkpoint is " + std::to_string(info.width) + "x" + std::to_string(info.height) + ", grid is "
+                + std::to_string(grid.width()) + "x" + std::to_string(grid.height()));
+    }
+
+    // Each update band copies its own rows, which leaves them in the cache (and
+    // memory) of the worker that steps them next. Bits past the right edge are
+    // cleared in case the file has any.
+    const auto* const words = reinterpret_cast<const uint64_t*>(file.data() + DATA_OFFSET);
+    const std::size_t wpr = static_cast<std::size_t>(grid.wordsPerRow());
+    const uint64_t lastWordMask = (info.width & 63) == 0 ? ~0ULL : (1ULL << (info.width & 63)) - 1;
+    grid.forEachBand([&](int begin, int end) {
+        std::memcpy(grid.rowForEdit(begin), words + (static_cast<std::size_t>(begin) * wpr), dataBytes(end - begin, grid.wordsPerRow()));
+        for (int x = begin; x < end; ++x) {
+            grid.rowForEdit(x)[wpr - 1] &= lastWordMask;
+        }
+    });
+    grid.setBoundary(info.boundary);
+    grid.setRule(info.rule);
+    grid.endEdits();
+    return info;
+}
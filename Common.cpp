@@ -2,15 +2,56 @@
 // Copyright (c) 2025 Faraz Fallahi <fffaraz@gmail.com>
 
 #include "Common.hpp"
+#include "Affinity.hpp"
 
+#include <climits>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <thread>
 
-void printAppInfo()
+bool parseGridSize(const char* text, GridSize& size)
+{
+    char* end = nullptr;
+    const long w = std::strtol(text, &end, 10);
+    long h = w;
+    if (*end == 'x' || *end == 'X') {
+        h = std::strtol(end + 1, &end, 10);
+    }
+    if (*end != '\0' || w <= 0 || h <= 0 || w > INT_MAX || h > INT_MAX) {
+        return false;
+    }
+    size = { static_cast<int>(w), static_cast<int>(h) };
+    return true;
+}
+
+GridSize gridSizeFromArgs(int argc, char** argv)
+{
+    GridSize size { GRID_SIZE, GRID_SIZE };
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "-s") == 0 || std::strcmp(argv[i], "--size") == 0) {
+            if (i + 1 >= argc) {
+                std::cerr << "Missing value for --size\n";
+                std::exit(1);
+            }
+            if (!parseGridSize(argv[++i], size)) {
+                std::cerr << "--size must be N or WxH with positive dimensions\n";
+                std::exit(1);
+            }
+        }
+    }
+    return size;
+}
+
+void printAppInfo(const GridSize& gridSize)
 {
     std::cout << "Conway's Game of Life\n";
     std::cout << "https://github.com/fffaraz/GameOfLife\n";
-    std::cout << "Grid size: " << GRID_SIZE << " x " << GRID_SIZE << "\n";
+    std::cout << "Grid size: " << gridSize.width << " x " << gridSize.height << "\n";
     std::cout << "Cell size: " << CELL_SIZE << " pixels\n";
+    std::cout << "SIMD kernel: " << simdLevelName(activeSimdLevel()) << "\n";
     std::cout << "Hardware concurrency: " << std::thread::hardware_concurrency() << "\n";
+    if (!workerCores().empty()) {
+        std::cout << "Worker cores: " << cpuListString(workerCores()) << "\n";
+    }
 }
@@ -3,13 +3,25 @@
 
 #pragma once
 
-#include "DoubleBuffer.hpp"
 #include "Grid.hpp"
+#include "TripleBuffer.hpp"
 
-constexpr int GRID_SIZE = 512; // Size of the grid in cells
+constexpr int GRID_SIZE = 512; // Default size of the grid in cells (--size overrides)
 constexpr int CELL_SIZE = 1; // Size of each cell in pixels
 constexpr int targetFPS = 30;
 
-using GridType = DoubleBuffer<Grid<GRID_SIZE>>;
+using GridType = TripleBuffer<DynamicGrid>;
 
-void printAppInfo();
+struct GridSize {
+    int width;
+    int height;
+};
+
+// Parse "N" (square) or "WxH"; false unless both dimensions are positive.
+bool parseGridSize(const char* text, GridSize& size);
+
+// Grid size from a `--size N|WxH` (or `-s`) argument, GRID_SIZE square if absent.
+// Exits with a message if the value does not parse.
+GridSize gridSizeFromArgs(int argc, char** argv);
+
+void printAppInfo(const GridSize& gridSize);
@@ -0,0 +1,56 @@
+// Conway's Game of Life
+// Copyright (c) 2025 Faraz Fallahi <fffaraz@gmail.com>
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+// Spots a run that has settled, from the content hash of each generation
+// (DynamicGrid::contentHash, fused into the update with setHashGenerations).
+// It remembers the last `history` hashes; a repeat is a cycle whose period is
+// the distance back: 1 for still lifes and empty grids, 2 for blinkers, and
+// so on. Cycles longer than the history go unnoticed. Two different grids
+// sharing a 64-bit hash would read as a cycle, but that is vanishingly rare.
+class CycleDetector {
+public:
+    static constexpr int DEFAULT_HISTORY = 64;
+
+    explicit CycleDetector(int history = DEFAULT_HISTORY)
+        : ring_(static_cast<std::size_t>(history > 0 ? history : 1))
+    {
+    }
+
+    int history() const { return static_cast<int>(ring_.size()); }
+
+    // Record the hash of `generation` (one more than the last one's) and return
+    // the shortest period it closes, if any.
+    std::optional<uint64_t> add(const uint64_t generation, const uint64_t hash)
+    {
+        std::optional<uint64_t> period;
+        for (std::size_t i = 0; i < size_ && !period; ++i) {
+            const Entry& e = ring_[(next_ + ring_.size() - 1 - i) % ring_.size()];
+            if (e.hash == hash) {
+                period = generation - e.generation;
+            }
+        }
+        ring_[next_] = { generation, hash };
+        next_ = (next_ + 1) % ring_.size();
+        size_ = size_ < ring_.size() ? size_ + 1 : size_;
+        return period;
+    }
+
+    void clear() { size_ = 0; }
+
+private:
+    struct Entry {
+        uint64_t generation = 0;
+        uint64_t hash = 0;
+    };
+
+    std::vector<Entry> ring_;
+    std::size_t next_ = 0;
+    std::size_t size_ = 0;
+};
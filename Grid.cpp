@@ -0,0 +1,1251 @@
+// Conway's Game of Life
+// Copyright (c) 2025 Faraz Fallahi <fffaraz@gmail.com>
+
+#include "Grid.hpp"
+#include "Affinity.hpp"
+#include "Random.hpp"
+#include "SwarKernel.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit> // std::countr_zero, std::popcount
+#include <cstdlib> // std::getenv, std::atoi
+#include <cstring> // std::strcmp
+#include <random>
+#include <stdexcept>
+
+#if 1 // Enable multithreaded calculation of grid updates
+#define PARALLEL_GRID 1
+#include "BandExecutor.hpp"
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread> // std::thread::hardware_concurrency
+#include <utility>
+
+namespace {
+
+// Worker count for a grid of `rows` rows. GOL_THREADS overrides everything; else
+// use up to half the hardware threads, but keep each band at least
+// MIN_ROWS_PER_BAND rows so the per-generation barrier + halo-coherence cost stays
+// amortized. Over-threading a small grid is a net loss: at 512x512, 16 bands run
+// ~3x slower than 4, because the tiny per-band work can't hide the sync overhead.
+int gridThreadsForRows(int rows)
+{
+    if (const char* env = std::getenv("GOL_THREADS")) {
+        const int n = std::atoi(env);
+        if (n > 0) {
+            return n;
+        }
+    }
+    constexpr int MIN_ROWS_PER_BAND = 128;
+    const int byHardware = static_cast<int>(std::max(1u, std::thread::hardware_concurrency() / 2));
+    const int byWork = std::max(1, rows / MIN_ROWS_PER_BAND);
+    return std::min(byHardware, byWork);
+}
+
+// One persistent worker pool per thread count and core list, created on first
+// use and shared by every grid that wants that many bands on those cores. Each
+// may have a render twin (see forEachRenderBand), created on its first frame.
+struct Pools {
+    std::mutex mutex;
+    std::map<std::pair<int, std::vector<int>>, std::unique_ptr<BandExecutor>> pools;
+    std::map<std::pair<int, std::vector<int>>, std::unique_ptr<BandExecutor>> renders;
+};
+
+Pools& gridPools()
+{
+    static Pools pools;
+    return pools;
+}
+
+// barrierSpin(), or none for a pool with more threads than the hardware runs
+// at once.
+std::chrono::nanoseconds poolSpin(int threads)
+{
+    return threads > static_cast<int>(std::thread::hardware_concurrency()) ? std::chrono::nanoseconds {} : barrierSpin();
+}
+
+BandExecutor& gridExecutor(int threads)
+{
+    Pools& pools = gridPools();
+    std::lock_guard lock(pools.mutex);
+    auto& exec = pools.pools[{ threads, workerCores() }];
+    if (!exec) {
+        exec = std::make_unique<BandExecutor>(threads, workerCores(), poolSpin(threads));
+    }
+    return *exec;
+}
+
+// The render twin of update pool `exec`: as many bands on the same cores. Its
+// waits park at once, as a frame comes every few milliseconds and a spinning
+// render worker would only hold the core its update twin needs.
+BandExecutor& renderExecutor(const BandExecutor& exec)
+{
+    Pools& pools = gridPools();
+    std::lock_guard lock(pools.mutex);
+    auto& render = pools.renders[{ exec.size(), exec.cores() }];
+    if (!render) {
+        render = std::make_unique<BandExecutor>(exec.size(), exec.cores());
+    }
+    return *render;
+}
+
+} // namespace
+#endif
+
+namespace {
+
+// Activity tracking (see DynamicGrid::beginUpdate): stable words are skipped
+// while fewer than 1/MAX_CHANGED_SHARE of them change; otherwise change bits are
+// re-measured every PROBE_INTERVAL generations.
+constexpr std::size_t MAX_CHANGED_SHARE = 8;
+constexpr int PROBE_INTERVAL = 16;
+
+// A fresh DynamicGrid::stamp_: never 0 and never handed out twice.
+uint64_t newStamp()
+{
+    static std::atomic<uint64_t> next { 1 };
+    return next.fetch_add(1, std::memory_order_relaxed);
+}
+
+// Set bit w of `bits` for each word w in [from, to) that differs between rows.
+void recordChanges(uint64_t* bits, const uint64_t* before, const uint64_t* after, const int from, const int to)
+{
+    for (int w = from; w < to;) {
+        const int chunkEnd = std::min(to, (w & ~63) + 64);
+        uint64_t mask = 0; // kept in a register: bits may alias nothing, but the compiler can't know
+        for (; w < chunkEnd; ++w) {
+            mask |= static_cast<uint64_t>(before[w] != after[w]) << (w & 63);
+        }
+        bits[(w - 1) >> 6] |= mask;
+    }
+}
+
+// Add (sign 1) or take back (sign -1) the births and deaths turning word self
+// into next. The totals are unsigned, but wrap back to the right value. Counts
+// go through WordOps, which avoids a library call per popcount in builds
+// without the popcnt instruction.
+inline void countWord(RowCounts& counts, const uint64_t self, const uint64_t next, const int sign)
+{
+    if (self != next) {
+        counts.births += static_cast<uint64_t>(sign) * WordOps::sumCounts(WordOps::bitCounts(next & ~self));
+        counts.deaths += static_cast<uint64_t>(sign) * WordOps::sumCounts(WordOps::bitCounts(self & ~next));
+    }
+}
+
+// First index >= from, below `size`, whose bit in `bits` equals `value`; size if none.
+int findBit(const uint64_t* bits, int from, const int size, const bool value)
+{
+    while (from < size) {
+        const uint64_t word = (value ? bits[from >> 6] : ~bits[from >> 6]) & (~0ULL << (from & 63));
+        if (word != 0) {
+            return std::min(size, (from & ~63) + std::countr_zero(word));
+        }
+        from = (from & ~63) + 64;
+    }
+    return size;
+}
+
+} // namespace
+
+const char* boundaryName(Boundary boundary)
+{
+    switch (boundary) {
+    case Boundary::Torus:
+        return "torus";
+    case Boundary::Reflect:
+        return "reflect";
+    case Boundary::Alive:
+        return "alive";
+    default:
+        return "dead";
+    }
+}
+
+bool parseBoundary(const char* text, Boundary& boundary)
+{
+    for (const Boundary b : { Boundary::Dead, Boundary::Torus, Boundary::Reflect, Boundary::Alive }) {
+        if (std::strcmp(text, boundaryName(b)) == 0) {
+            boundary = b;
+            return true;
+        }
+    }
+    return false;
+}
+
+const char* scheduleName(Schedule schedule)
+{
+    switch (schedule) {
+    case Schedule::Static:
+        return "static";
+    case Schedule::Stealing:
+        return "stealing";
+    default:
+        return "auto";
+    }
+}
+
+bool parseSchedule(const char* text, Schedule& schedule)
+{
+    for (const Schedule s : { Schedule::Auto, Schedule::Static, Schedule::Stealing }) {
+        if (std::strcmp(text, scheduleName(s)) == 0) {
+            schedule = s;
+            return true;
+        }
+    }
+    return false;
+}
+
+namespace {
+
+std::vector<int>& coresSetting()
+{
+    static std::vector<int> cores = [] {
+        std::vector<int> list;
+        const char* env = std::getenv("GOL_PIN");
+        if (env != nullptr && !parseCpuList(env, list)) {
+            list.clear();
+        }
+        return list;
+    }();
+    return cores;
+}
+
+} // namespace
+
+const std::vector<int>& workerCores()
+{
+    return coresSetting();
+}
+
+void setWorkerCores(const std::vector<int>& cores)
+{
+    coresSetting() = cores;
+}
+
+namespace {
+
+constexpr std::chrono::microseconds DEFAULT_BARRIER_SPIN { 50 };
+
+std::chrono::microseconds& spinSetting()
+{
+    static std::chrono::microseconds spin = [] {
+        if (const char* env = std::getenv("GOL_SPIN_US")) {
+            const int us = std::atoi(env);
+            if (us >= 0) {
+                return std::chrono::microseconds(us);
+            }
+        }
+        return DEFAULT_BARRIER_SPIN;
+    }();
+    return spin;
+}
+
+} // namespace
+
+std::chrono::microseconds barrierSpin()
+{
+    return spinSetting();
+}
+
+void setBarrierSpin(const std::chrono::microseconds spin)
+{
+    spinSetting() = spin;
+#ifdef PARALLEL_GRID
+    Pools& pools = gridPools();
+    std::lock_guard lock(pools.mutex);
+    for (auto& [key, exec] : pools.pools) {
+        exec->setSpin(poolSpin(key.first));
+    }
+#endif
+}
+
+DynamicGrid::DynamicGrid(int width, int height)
+    : width_(width)
+    , height_(height)
+    , wordsPerRow_((width + 63) / 64)
+    , lastWordMask_(~0ULL >> ((64 - (width & 63)) & 63))
+{
+    if (width <= 0 || height <= 0) {
+        throw std::invalid_argument("grid dimensions must be positive");
+    }
+    words_.resize(static_cast<std::size_t>(height_) * wordsPerRow_); // zeroed below
+    changedStride_ = (wordsPerRow_ + 63) / 64;
+    changed_.assign(static_cast<std::size_t>(height_) * changedStride_, 0);
+    rowChanged_.assign(height_, 0);
+    rowCounts_.assign(height_, RowCounts {});
+    rowHashes_.assign(height_, 0);
+    markAllChanged();
+    stamp_ = newStamp();
+    zeroRow_.assign(wordsPerRow_, 0);
+    onesRow_.assign(wordsPerRow_, ~0ULL);
+    onesRow_.back() = lastWordMask_;
+#ifdef PARALLEL_GRID
+    exec_ = &gridExecutor(gridThreadsForRows(height_));
+#endif
+    placeRows(nullptr, words_.data());
+}
+
+void DynamicGrid::setThreads(const int threads)
+{
+#ifdef PARALLEL_GRID
+    BandExecutor& exec = gridExecutor(threads > 0 ? threads : gridThreadsForRows(height_));
+    if (&exec != exec_) {
+        exec_ = &exec;
+        std::vector<uint64_t, AlignedAllocator<uint64_t>> placed;
+        placed.resize(words_.size());
+        placeRows(words_.data(), placed.data());
+        words_.swap(placed);
+    }
+#else
+    static_cast<void>(threads);
+#endif
+}
+
+// Fill `to`, fresh words that nothing has written yet (a resize leaves them
+// so), with from's rows or zeros, each band writing its own rows: the
+// first-touch policy then puts them on the node of the worker that updates them.
+void DynamicGrid::placeRows(const uint64_t* const from, uint64_t* const to) const
+{
+    const std::size_t wpr = wordsPerRow_;
+    forEachBand([from, to, wpr](int begin, int end) {
+        const std::size_t first = static_cast<std::size_t>(begin) * wpr;
+        const std::size_t count = static_cast<std::size_t>(end - begin) * wpr;
+        if (from != nullptr) {
+            std::copy_n(from + first, count, to + first);
+        } else {
+            std::fill_n(to + first, count, 0ULL);
+        }
+    });
+}
+
+// State of cell (x, y), which may lie one step outside the grid; the boundary
+// mode says what is there.
+bool DynamicGrid::cellOrBoundary(int x, int y) const
+{
+    if (x >= 0 && x < height_ && y >= 0 && y < width_) {
+        return get({ x, y });
+    }
+    switch (boundary_) {
+    case Boundary::Torus:
+        return get({ (x + height_) % height_, (y + width_) % width_ });
+    case Boundary::Reflect:
+        return get({ std::clamp(x, 0, height_ - 1), std::clamp(y, 0, width_ - 1) });
+    case Boundary::Alive:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// Count the number of live neighbors for the cell at (x, y), by bit extraction
+// with bounds checks: fine for single cells; neighborPlanes does whole rows.
+int DynamicGrid::countLiveNeighbors(const Point& p) const
+{
+    int liveNeighbors = 0;
+    for (int i = -1; i <= 1; ++i) {
+        for (int j = -1; j <= 1; ++j) {
+            if (i == 0 && j == 0)
+                continue; // Skip the cell itself
+            liveNeighbors += cellOrBoundary(p.x + i, p.y + j) ? 1 : 0;
+        }
+    }
+    return liveNeighbors;
+}
+
+// Toggle a 3x3 block of cells at the given position
+void DynamicGrid::toggleBlock(const Point& p)
+{
+    const int size = 1;
+    for (int i = -size; i <= size; ++i) {
+        for (int j = -size; j <= size; ++j) {
+            const Point n { p.x + i, p.y + j };
+            if (n.x >= 0 && n.x < height_ && n.y >= 0 && n.y < width_) {
+                toggle(n);
+            }
+        }
+    }
+}
+
+// Redo a row's first and last cell for a non-Dead boundary. The row kernel always
+// shifts zeros in past the left/right edge, and the column outside an edge only
+// neighbors the edge cell itself, so just those two cells need recounting with
+// the boundary's value for the outside column. O(1) per row, so the kernel's
+// interior loop is the same for every mode.
+template <Boundary B>
+void DynamicGrid::fixEdgeCells(const uint64_t* a, const uint64_t* b, const uint64_t* c, uint64_t* out) const
+{
+    const int lastCol = width_ - 1;
+    const auto cell = [](const uint64_t* row, int col) -> int { return static_cast<int>((row[col >> 6] >> (col & 63)) & 1); };
+    const auto outsideLeft = [&](const uint64_t* row) -> int {
+        if constexpr (B == Boundary::Torus) {
+            return cell(row, lastCol);
+        } else if constexpr (B == Boundary::Reflect) {
+            return cell(row, 0);
+        } else {
+            return 1;
+        }
+    };
+    const auto outsideRight = [&](const uint64_t* row) -> int {
+        if constexpr (B == Boundary::Torus) {
+            return cell(row, 0);
+        } else if constexpr (B == Boundary::Reflect) {
+            return cell(row, lastCol);
+        } else {
+            return 1;
+        }
+    };
+    // The rule for one cell with n live neighbors, written back into out.
+    const auto store = [&](int col, int n) {
+        const uint64_t alive = rule_.next(cell(b, col), n) ? 1 : 0;
+        uint64_t& w = out[col >> 6];
+        w = (w & ~(1ULL << (col & 63))) | (alive << (col & 63));
+    };
+
+    const int right0 = width_ > 1 ? cell(a, 1) + cell(b, 1) + cell(c, 1) : outsideRight(a) + outsideRight(b) + outsideRight(c);
+    store(0, outsideLeft(a) + outsideLeft(b) + outsideLeft(c) + cell(a, 0) + cell(c, 0) + right0);
+    if (width_ > 1) {
+        const int left = cell(a, lastCol - 1) + cell(b, lastCol - 1) + cell(c, lastCol - 1);
+        store(lastCol, left + cell(a, lastCol) + cell(c, lastCol) + outsideRight(a) + outsideRight(b) + outsideRight(c));
+    }
+}
+
+// Every word of every row counts as changed: the next step computes it all.
+void DynamicGrid::markAllChanged()
+{
+    const uint64_t lastBits = ~0ULL >> ((64 - (wordsPerRow_ & 63)) & 63);
+    for (int x = 0; x < height_; ++x) {
+        uint64_t* const bits = changedRow(x);
+        std::fill(bits, bits + changedStride_, ~0ULL);
+        bits[changedStride_ - 1] = lastBits;
+    }
+    std::fill(rowChanged_.begin(), rowChanged_.end(), uint8_t { 1 });
+    changedKnown_ = true;
+    changedWords_ = words_.size();
+}
+
+// Update one row with the SWAR kernel (see SwarKernel.hpp), which evaluates 64
+// cells per word -- or 256/512 per step with the AVX2/AVX-512 kernels.
+// The row above/below the grid is a zero row (Dead), the opposite edge row
+// (Torus), the edge row itself (Reflect) or a ones row (Alive). Left/right, the
+// kernel shifts zeros in past the first/last word, which is already right for
+// Dead; other modes patch the two edge cells afterwards. B is a template
+// parameter, so Dead pays nothing for the other modes.
+// A partial last word needs no special case on the way in, since its bits past
+// the edge are zero too; the kernel can only give birth there, so one mask per
+// row clears them again.
+template <Boundary B>
+inline void DynamicGrid::updateRow(const DynamicGrid& current, const int x, const RowKernel kernel, uint64_t* const changed, RowCounts* const counts)
+{
+    const int wpr = wordsPerRow_;
+    const uint64_t* const cur = current.words_.data();
+    const uint64_t* const mid = cur + (x * wpr);
+    evalRow<B>(rowAbove<B>(cur, x), mid, rowBelow<B>(cur, x), words_.data() + (x * wpr), kernel, changed, counts);
+}
+
+// updateRow that recomputes only words next to a change; this grid must still
+// hold current's previous generation. Change bits compare a generation with the
+// one two back, which is what the ping-pong destination is about to lose: if a
+// word and its eight neighbors equal their values two generations back, its
+// 3x3 neighborhoods repeat, so its next value repeats the previous one -- which
+// is already here. Still lifes and period-2 oscillators, most of what a
+// settled soup leaves, therefore cost nothing. A run of dirty words goes
+// through the runtime-width kernel widened by a word on each side, so its edge
+// words see their real neighbors; those two clean words come out wrong (the
+// kernel shifts zeros in past the span) and are restored after. `dirty` and
+// `prev` are per-row scratch for the dirty bitmap and the overwritten words.
+// A skipped word still changes from mid when it belongs to a period-2
+// oscillator, so a row that is counted gets counted word by word once done.
+template <Boundary B>
+inline void DynamicGrid::updateActiveRow(const Pass& pass, const int x, uint64_t* const dirty, uint64_t* const prev, RowCounts* const counts)
+{
+    const DynamicGrid& current = pass.current;
+    const int wpr = wordsPerRow_;
+    const int stride = changedStride_;
+    const uint64_t* const cur = current.words_.data();
+    const uint64_t* const mid = cur + (x * wpr);
+    uint64_t* const out = words_.data() + (x * wpr);
+    uint64_t* const bits = changedRow(x);
+
+    const int up = x > 0 ? x - 1 : (B == Boundary::Torus ? height_ - 1 : x);
+    const int down = x < height_ - 1 ? x + 1 : (B == Boundary::Torus ? 0 : x);
+    const uint64_t* const changedUp = current.changedRow(up);
+    const uint64_t* const changedMid = current.changedRow(x);
+    const uint64_t* const changedDown = current.changedRow(down);
+    uint64_t any = 0;
+    for (int i = 0; i < stride; ++i) {
+        dirty[i] = changedUp[i] | changedMid[i] | changedDown[i];
+        any |= dirty[i];
+    }
+    if (any == 0) {
+        return;
+    }
+
+    // Spread each changed word to its left and right neighbors (and across the
+    // wrap on a torus).
+    const bool wrapLeft = B == Boundary::Torus && (dirty[0] & 1);
+    const bool wrapRight = B == Boundary::Torus && ((dirty[stride - 1] >> ((wpr - 1) & 63)) & 1);
+    uint64_t carry = 0;
+    for (int i = 0; i < stride; ++i) {
+        const uint64_t m = dirty[i];
+        const uint64_t nextLow = i + 1 < stride ? (dirty[i + 1] & 1) : 0;
+        dirty[i] = m | (m << 1) | (m >> 1) | carry | (nextLow << 63);
+        carry = m >> 63;
+    }
+    if (wrapLeft) {
+        dirty[stride - 1] |= 1ULL << ((wpr - 1) & 63);
+    }
+    if (wrapRight) {
+        dirty[0] |= 1;
+    }
+    dirty[stride - 1] &= ~0ULL >> ((64 - (wpr & 63)) & 63);
+
+    const uint64_t* const top = rowAbove<B>(cur, x);
+    const uint64_t* const bot = rowBelow<B>(cur, x);
+    if (findBit(dirty, 0, wpr, false) == wpr) {
+        evalRow<B>(top, mid, bot, out, pass.kernel, bits, counts);
+        return;
+    }
+    const uint64_t first = out[0];
+    const uint64_t last = out[wpr - 1];
+    for (int s = findBit(dirty, 0, wpr, true); s < wpr;) {
+        const int e = findBit(dirty, s, wpr, false);
+        const int lo = std::max(0, s - 1);
+        const int hi = std::min(wpr, e + 1);
+        std::copy(out + lo, out + hi, prev + lo);
+        pass.spanKernel(top + lo, mid + lo, bot + lo, out + lo, hi - lo, rule_, nullptr, nullptr);
+        if (lo < s) {
+            out[lo] = prev[lo];
+        }
+        if (hi > e) {
+            out[hi - 1] = prev[hi - 1];
+        }
+        recordChanges(bits, prev, out, s, e);
+        s = findBit(dirty, e, wpr, true);
+    }
+    if constexpr (B != Boundary::Dead) {
+        fixEdgeCells<B>(top, mid, bot, out);
+    }
+    out[wpr - 1] &= lastWordMask_;
+    redoEdgeChanges(bits, first, last, out);
+    if (counts != nullptr) {
+        pass.countKernel(mid, out, wpr, *counts);
+    }
+}
+
+// The rows above/below row x of the grid at cur: the neighboring row, or past
+// the top/bottom edge what the boundary puts there.
+template <Boundary B>
+inline const uint64_t* DynamicGrid::rowAbove(const uint64_t* cur, const int x) const
+{
+    const int wpr = wordsPerRow_;
+    if (x > 0) {
+        return cur + ((x - 1) * wpr);
+    }
+    if constexpr (B == Boundary::Torus) {
+        return cur + ((height_ - 1) * wpr);
+    } else {
+        return outsideRow<B>(cur);
+    }
+}
+
+template <Boundary B>
+inline const uint64_t* DynamicGrid::rowBelow(const uint64_t* cur, const int x) const
+{
+    const int wpr = wordsPerRow_;
+    if (x < height_ - 1) {
+        return cur + ((x + 1) * wpr);
+    }
+    if constexpr (B == Boundary::Torus) {
+        return cur;
+    } else {
+        return outsideRow<B>(cur + (x * wpr));
+    }
+}
+
+// The row past a non-Torus top/bottom edge whose edge row is `edge`.
+template <Boundary B>
+inline const uint64_t* DynamicGrid::outsideRow(const uint64_t* edge) const
+{
+    if constexpr (B == Boundary::Reflect) {
+        return edge;
+    } else if constexpr (B == Boundary::Alive) {
+        return onesRow_.data();
+    } else {
+        return zeroRow_.data();
+    }
+}
+
+// One row through the kernel and the edge fix-ups. Unless changed is null, it
+// gets bit w set for each word w of out that differs from what it overwrote;
+// unless counts is null, the row's births and deaths are added to it.
+template <Boundary B>
+inline void DynamicGrid::evalRow(const uint64_t* top, const uint64_t* mid, const uint64_t* bot, uint64_t* out, const RowKernel kernel, uint64_t* const changed, RowCounts* const counts) const
+{
+    const int wpr = wordsPerRow_;
+    const uint64_t first = out[0];
+    const uint64_t last = out[wpr - 1];
+    kernel(top, mid, bot, out, wpr, rule_, changed, counts);
+    const bool patched = B != Boundary::Dead || lastWordMask_ != ~0ULL;
+    if (counts != nullptr && patched) {
+        countEdgeWords(*counts, mid, out, -1);
+    }
+    if constexpr (B != Boundary::Dead) {
+        fixEdgeCells<B>(top, mid, bot, out);
+    }
+    out[wpr - 1] &= lastWordMask_;
+    if (counts != nullptr && patched) {
+        countEdgeWords(*counts, mid, out, 1);
+    }
+    if (changed != nullptr && patched) {
+        redoEdgeChanges(changed, first, last, out);
+    }
+}
+
+// The kernel saw a row's edge words before the edge fix-up and the partial-word
+// mask; set their change bits again from the words they replaced.
+void DynamicGrid::redoEdgeChanges(uint64_t* changed, const uint64_t first, const uint64_t last, const uint64_t* out) const
+{
+    const int lastWord = wordsPerRow_ - 1;
+    changed[0] = (changed[0] & ~1ULL) | static_cast<uint64_t>(out[0] != first);
+    uint64_t& lastBits = changed[lastWord >> 6];
+    lastBits = (lastBits & ~(1ULL << (lastWord & 63))) | (static_cast<uint64_t>(out[lastWord] != last) << (lastWord & 63));
+}
+
+// Likewise for the kernel's births and deaths: take the edge words' counts off
+// before the fix-up and mask (sign -1), and add them back after (sign 1).
+void DynamicGrid::countEdgeWords(RowCounts& counts, const uint64_t* mid, const uint64_t* out, const int sign) const
+{
+    const int lastWord = wordsPerRow_ - 1;
+    countWord(counts, mid[0], out[0], sign);
+    if (lastWord > 0) {
+        countWord(counts, mid[lastWord], out[lastWord], sign);
+    }
+}
+
+// Births and deaths of a row updateRows skipped, counted from the words: it
+// still changes from current's if it oscillates with period 2.
+void DynamicGrid::countSkippedRow(const Pass& pass, const int x, RowCounts& counts)
+{
+    RowCounts& row = rowCounts_[x];
+    row = {};
+    const std::size_t offset = static_cast<std::size_t>(x) * wordsPerRow_;
+    pass.countKernel(pass.current.words_.data() + offset, words_.data() + offset, wordsPerRow_, row);
+    counts.births += row.births;
+    counts.deaths += row.deaths;
+}
+
+// Rows [begin, end) for one pass; returns how many of their words changed (0
+// when the pass does not track them) and, if it counts them, their births and
+// deaths.
+template <Boundary B>
+DynamicGrid::BandTotals DynamicGrid::updateRows(const Pass& pass, const int begin, const int end)
+{
+    BandTotals totals;
+    RowCounts* const counts = pass.counting ? &totals.counts : nullptr;
+    if (pass.activity == Activity::Off) {
+        for (int x = begin; x < end; ++x) {
+            updateRow<B>(pass.current, x, pass.kernel, nullptr, counts);
+            if (pass.hashKernel != nullptr) {
+                rowHashes_[x] = hashRow(x, pass.hashKernel);
+                totals.hash += rowHashes_[x];
+            }
+        }
+        return totals;
+    }
+    thread_local std::vector<uint64_t> dirty;
+    thread_local std::vector<uint64_t> prev;
+    dirty.resize(changedStride_);
+    prev.resize(wordsPerRow_);
+    // A row with no change in itself or the rows next to it is skipped without
+    // looking at its bitmap; its own bits are already zero unless its flag says
+    // otherwise.
+    // Counted rows keep their counts in rowCounts_. A skipped row has the same
+    // ones as when this grid last computed it: it repeats that generation, and
+    // current repeats the one before. So once those are known (countDelta),
+    // skipped rows cost nothing and the others report how their counts moved.
+    const uint8_t* const rowsChanged = pass.current.rowChanged_.data();
+    const bool skip = pass.activity == Activity::Skip;
+    for (int x = begin; x < end; ++x) {
+        if (skip) {
+            const int up = x > 0 ? x - 1 : (B == Boundary::Torus ? height_ - 1 : x);
+            const int down = x < height_ - 1 ? x + 1 : (B == Boundary::Torus ? 0 : x);
+            if ((rowsChanged[up] | rowsChanged[x] | rowsChanged[down]) == 0) {
+                if (rowChanged_[x] != 0) {
+                    std::fill(changedRow(x), changedRow(x) + changedStride_, 0ULL);
+                    rowChanged_[x] = 0;
+                }
+                if (counts != nullptr && !pass.countDelta) {
+                    countSkippedRow(pass, x, *counts);
+                }
+                if (pass.hashKernel != nullptr) {
+                    if (!pass.rowHashesKnown) {
+                        rowHashes_[x] = hashRow(x, pass.hashKernel);
+                    }
+                    totals.hash += rowHashes_[x];
+                }
+                continue;
+            }
+        }
+        uint64_t* const bits = changedRow(x);
+        std::fill(bits, bits + changedStride_, 0ULL);
+        RowCounts row;
+        RowCounts* const rowCounts = counts != nullptr ? &row : nullptr;
+        if (skip) {
+            updateActiveRow<B>(pass, x, dirty.data(), prev.data(), rowCounts);
+        } else {
+            updateRow<B>(pass.current, x, pass.kernel, bits, rowCounts);
+        }
+        if (counts != nullptr) {
+            const RowCounts before = pass.countDelta ? rowCounts_[x] : RowCounts {};
+            counts->births += row.births - before.births;
+            counts->deaths += row.deaths - before.deaths;
+            rowCounts_[x] = row;
+        }
+        if (pass.hashKernel != nullptr) {
+            rowHashes_[x] = hashRow(x, pass.hashKernel);
+            totals.hash += rowHashes_[x];
+        }
+        std::size_t rowChanged = 0;
+        for (int i = 0; i < changedStride_; ++i) {
+            rowChanged += static_cast<std::size_t>(std::popcount(bits[i]));
+        }
+        rowChanged_[x] = rowChanged != 0 ? 1 : 0;
+        totals.changedWords += rowChanged;
+    }
+    return totals;
+}
+
+// Rows [begin, end) with the boundary mode resolved once per band.
+DynamicGrid::BandTotals DynamicGrid::updateBand(const Pass& pass, const int begin, const int end)
+{
+    switch (boundary_) {
+    case Boundary::Torus:
+        return updateRows<Boundary::Torus>(pass, begin, end);
+    case Boundary::Reflect:
+        return updateRows<Boundary::Reflect>(pass, begin, end);
+    case Boundary::Alive:
+        return updateRows<Boundary::Alive>(pass, begin, end);
+    default:
+        return updateRows<Boundary::Dead>(pass, begin, end);
+    }
+}
+
+// Adopt current's mode and rule, and decide how much activity tracking the
+// pass does. Tracking needs this grid to still hold current's previous
+// generation -- current was computed from it and it has not been touched since,
+// as in the usual ping-pong -- since change bits compare against the words
+// being overwritten. Skipping stable words pays off only while few of them
+// change: past MAX_CHANGED_SHARE the bookkeeping costs more than it saves, so
+// the grid runs untracked and records one generation of change bits every
+// PROBE_INTERVAL to notice when it has settled down.
+DynamicGrid::Pass DynamicGrid::beginUpdate(const DynamicGrid& current)
+{
+    const bool inPlace = this != &current && stamp_ != 0 && current.sourceStamp_ == stamp_;
+    boundary_ = current.boundary_;
+    rule_ = current.rule_;
+    schedule_ = current.schedule_;
+    collectStats_ = current.collectStats_;
+    hashGenerations_ = current.hashGenerations_;
+    const std::size_t words = words_.size();
+    Activity activity = Activity::Off;
+    if (inPlace && current.changedKnown_ && current.changedWords_ * MAX_CHANGED_SHARE < words) {
+        activity = Activity::Skip;
+    } else if (inPlace && current.untracked_ + 1 >= PROBE_INTERVAL) {
+        activity = Activity::Record;
+    }
+    const SimdLevel level = activeSimdLevel();
+    const bool countDelta = activity == Activity::Skip && collectStats_ && rowCountsKnown_;
+    const bool skip = activity == Activity::Skip;
+    return { current, rowKernel(level, wordsPerRow_, rule_), skip ? rowKernel(level, 0, rule_) : nullptr, skip && collectStats_ ? countKernel(level) : nullptr, activity, collectStats_, countDelta,
+        hashGenerations_ ? hashKernel(level) : nullptr, hashKnown() };
+}
+
+// The population follows from current's plus the births and deaths; current's
+// takes a popcount pass only when it is not known, e.g. right after turning
+// stats on.
+void DynamicGrid::finishUpdate(const Pass& pass, const BandTotals& totals)
+{
+    const DynamicGrid& current = pass.current;
+    const RowCounts before = pass.countDelta ? RowCounts { static_cast<uint64_t>(births_), static_cast<uint64_t>(deaths_) } : RowCounts {};
+    changedKnown_ = pass.activity != Activity::Off;
+    changedWords_ = totals.changedWords;
+    untracked_ = changedKnown_ ? 0 : current.untracked_ + 1;
+    sourceStamp_ = current.stamp_;
+    stamp_ = newStamp();
+    statsKnown_ = collectStats_;
+    rowCountsKnown_ = changedKnown_ && collectStats_;
+    if (collectStats_) {
+        births_ = static_cast<long long>(before.births + totals.counts.births);
+        deaths_ = static_cast<long long>(before.deaths + totals.counts.deaths);
+        population_ = current.population() + births_ - deaths_;
+    } else {
+        population_ = -1;
+    }
+    if (pass.hashKernel != nullptr) {
+        contentHash_ = totals.hash;
+        hashStamp_ = stamp_;
+    }
+}
+
+// Rows [begin, end) of *this become current's rows `generations` generations on.
+// The block copies its rows plus a halo of `generations` rows on each side into
+// scratch (wrapping for Torus, clipped at the grid edge otherwise) and steps the
+// copy there: each generation the outermost halo row goes stale, so the range
+// still computed shrinks by one row per side until only [begin, end) is left,
+// which the last generation writes straight into the grid. Blocks never read
+// each other's output, so they need no sync in between. When collecting stats,
+// the last generation is counted, and its rows popcounted while still in cache:
+// the population `generations` - 1 back is not known to build on.
+template <Boundary B>
+DynamicGrid::BandTotals DynamicGrid::updateRowsBlocked(const DynamicGrid& current, const int begin, const int end, const int generations, const RowKernel kernel)
+{
+    BandTotals totals;
+    constexpr bool WRAP = B == Boundary::Torus;
+    const int wpr = wordsPerRow_;
+    const int lo = WRAP ? begin - generations : std::max(0, begin - generations);
+    const int hi = WRAP ? end + generations : std::min(height_, end + generations);
+    const std::size_t rowCount = static_cast<std::size_t>(hi - lo);
+    // Per-thread and reused, so only the first block of a given size allocates.
+    thread_local std::vector<uint64_t, AlignedAllocator<uint64_t>> scratch;
+    if (scratch.size() < 2 * rowCount * wpr) {
+        scratch.resize(2 * rowCount * wpr);
+    }
+    uint64_t* src = scratch.data();
+    uint64_t* dst = src + (rowCount * wpr);
+    for (int r = lo; r < hi; ++r) {
+        const int x = WRAP ? ((r % height_) + height_) % height_ : r;
+        std::copy_n(current.words_.data() + (static_cast<std::size_t>(x) * wpr), wpr, src + (static_cast<std::size_t>(r - lo) * wpr));
+    }
+    // Halo rows that end at a real grid edge stay exact: the boundary supplies
+    // their outside neighbor, just as in updateRow.
+    const bool topEdge = !WRAP && lo == 0;
+    const bool bottomEdge = !WRAP && hi == height_;
+    const HashKernel hasher = hashGenerations_ ? hashKernel(activeSimdLevel()) : nullptr;
+    for (int g = 1; g <= generations; ++g) {
+        const bool last = g == generations;
+        const int from = last ? begin : (topEdge ? lo : lo + g);
+        const int to = last ? end : (bottomEdge ? hi : hi - g);
+        for (int r = from; r < to; ++r) {
+            const uint64_t* const mid = src + (static_cast<std::size_t>(r - lo) * wpr);
+            const uint64_t* const top = r > lo ? mid - wpr : outsideRow<B>(mid);
+            const uint64_t* const bot = r < hi - 1 ? mid + wpr : outsideRow<B>(mid);
+            uint64_t* const out = last ? words_.data() + (static_cast<std::size_t>(r) * wpr) : dst + (static_cast<std::size_t>(r - lo) * wpr);
+            evalRow<B>(top, mid, bot, out, kernel, nullptr, last && collectStats_ ? &totals.counts : nullptr);
+            if (last && collectStats_) {
+                for (int w = 0; w < wpr; ++w) {
+                    totals.population += static_cast<uint64_t>(std::popcount(out[w]));
+                }
+            }
+            if (last && hasher != nullptr) {
+                rowHashes_[r] = hashRow(r, hasher);
+                totals.hash += rowHashes_[r];
+            }
+        }
+        std::swap(src, dst);
+    }
+    return totals;
+}
+
+DynamicGrid::BandTotals DynamicGrid::updateBandBlocked(const DynamicGrid& current, const int begin, const int end, const int generations, const RowKernel kernel)
+{
+    switch (boundary_) {
+    case Boundary::Torus:
+        return updateRowsBlocked<Boundary::Torus>(current, begin, end, generations, kernel);
+    case Boundary::Reflect:
+        return updateRowsBlocked<Boundary::Reflect>(current, begin, end, generations, kernel);
+    case Boundary::Alive:
+        return updateRowsBlocked<Boundary::Alive>(current, begin, end, generations, kernel);
+    default:
+        return updateRowsBlocked<Boundary::Dead>(current, begin, end, generations, kernel);
+    }
+}
+
+void DynamicGrid::finishBlockedUpdate(const DynamicGrid& current, const int generations, const BandTotals& totals)
+{
+    // No change bits, and current is `generations` back, not the previous generation.
+    changedKnown_ = false;
+    untracked_ = current.untracked_ + generations;
+    sourceStamp_ = 0;
+    stamp_ = newStamp();
+    statsKnown_ = collectStats_;
+    rowCountsKnown_ = false;
+    births_ = static_cast<long long>(totals.counts.births);
+    deaths_ = static_cast<long long>(totals.counts.deaths);
+    population_ = collectStats_ ? static_cast<long long>(totals.population) : -1;
+    if (hashGenerations_) {
+        contentHash_ = totals.hash;
+        hashStamp_ = stamp_;
+    }
+}
+
+template <Boundary B>
+void DynamicGrid::neighborPlanesOf(const int x, uint64_t* const planes) const
+{
+    const int wpr = wordsPerRow_;
+    const uint64_t* const cur = words_.data();
+    neighborKernel(activeSimdLevel())(rowAbove<B>(cur, x), cur + (x * wpr), rowBelow<B>(cur, x), planes, wpr);
+    // As in evalRow, the kernel shifted zeros in past the left and right edge:
+    // recount the edge cells, and clear the counts past the edge.
+    const auto setCount = [planes, wpr](int col, int n) {
+        for (int k = 0; k < 4; ++k) {
+            uint64_t& w = planes[(k * wpr) + (col >> 6)];
+            w = (w & ~(1ULL << (col & 63))) | (static_cast<uint64_t>((n >> k) & 1) << (col & 63));
+        }
+    };
+    if constexpr (B != Boundary::Dead) {
+        setCount(0, countLiveNeighbors({ x, 0 }));
+        setCount(width_ - 1, countLiveNeighbors({ x, width_ - 1 }));
+    }
+    for (int k = 0; k < 4; ++k) {
+        planes[(k * wpr) + wpr - 1] &= lastWordMask_;
+    }
+}
+
+void DynamicGrid::neighborPlanes(const int x, uint64_t* const planes) const
+{
+    switch (boundary_) {
+    case Boundary::Torus:
+        return neighborPlanesOf<Boundary::Torus>(x, planes);
+    case Boundary::Reflect:
+        return neighborPlanesOf<Boundary::Reflect>(x, planes);
+    case Boundary::Alive:
+        return neighborPlanesOf<Boundary::Alive>(x, planes);
+    default:
+        return neighborPlanesOf<Boundary::Dead>(x, planes);
+    }
+}
+
+long long DynamicGrid::population() const
+{
+    if (population_ >= 0) {
+        return population_;
+    }
+    long long alive = 0;
+    for (const uint64_t w : words_) {
+        alive += std::popcount(w);
+    }
+    return alive;
+}
+
+uint64_t DynamicGrid::hashRow(const int x, const HashKernel kernel) const
+{
+    const std::size_t first = static_cast<std::size_t>(x) * wordsPerRow_;
+    return kernel(words_.data() + first, wordsPerRow_, first);
+}
+
+uint64_t DynamicGrid::contentHash() const
+{
+    if (hashKnown()) {
+        return contentHash_;
+    }
+    const HashKernel kernel = hashKernel(activeSimdLevel());
+    uint64_t h = 0;
+    for (int x = 0; x < height_; ++x) {
+        h += hashRow(x, kernel);
+    }
+    return h;
+}
+
+std::optional<GenerationStats> DynamicGrid::stats() const
+{
+    if (!statsKnown_) {
+        return std::nullopt;
+    }
+    return GenerationStats { population_, births_, deaths_ };
+}
+
+BandStats DynamicGrid::bandStats() const
+{
+#ifdef PARALLEL_GRID
+    return exec_->stats();
+#else
+    return {};
+#endif
+}
+
+void DynamicGrid::resetBandStats() const
+{
+#ifdef PARALLEL_GRID
+    exec_->resetStats();
+#endif
+}
+
+int DynamicGrid::bandCount() const
+{
+#ifdef PARALLEL_GRID
+    return exec_->size();
+#else
+    return 1;
+#endif
+}
+
+// Blocks for temporal blocking: at least one per band, and enough that a block's
+// two scratch copies stay within about an L2 cache, so its k generations run out
+// of cache instead of streaming the grid from memory once per generation.
+int DynamicGrid::temporalBlocks() const
+{
+    constexpr std::size_t BLOCK_BYTES = std::size_t { 1 } << 20;
+    const int bands = bandCount();
+    const std::size_t gridBytes = static_cast<std::size_t>(height_) * wordsPerRow_ * sizeof(uint64_t);
+    const int byCache = static_cast<int>(std::min<std::size_t>((2 * gridBytes + BLOCK_BYTES - 1) / BLOCK_BYTES, height_));
+    const int blocks = std::max(bands, byCache);
+    return std::min(height_, (blocks + bands - 1) / bands * bands);
+}
+
+// k for updateGrid(current, k). One generation when there is nothing to save:
+// a single band whose grid already fits in cache has no barrier to amortize
+// and no memory traffic to cut. Also one while single steps skip most of the
+// grid as stable, or to let them measure that again. Otherwise k grows with
+// the block height, up to MAX_GENERATIONS: each block recomputes about k rows
+// per side per sync, so keeping k at 1/16 of the block keeps that redundant
+// work near 1/8 of a generation's worth while barriers and full-grid passes
+// drop k-fold.
+int DynamicGrid::generationsPerUpdate() const
+{
+    constexpr int MAX_GENERATIONS = 8;
+    constexpr int ROWS_PER_GENERATION = 16;
+    const int bands = bandCount();
+    const int blocks = temporalBlocks();
+    if (bands == 1 && blocks == 1) {
+        return 1;
+    }
+    if ((changedKnown_ && changedWords_ * MAX_CHANGED_SHARE < words_.size()) || untracked_ + 1 >= PROBE_INTERVAL) {
+        return 1;
+    }
+    return std::clamp(height_ / blocks / ROWS_PER_GENERATION, 1, MAX_GENERATIONS);
+}
+
+#ifndef PARALLEL_GRID
+
+void DynamicGrid::runBands(void (*const thunk)(void*, int, int), void* const ctx) const
+{
+    thunk(ctx, 0, height_);
+}
+
+void DynamicGrid::runRenderBands(void (*const thunk)(void*, int, int), void* const ctx) const
+{
+    thunk(ctx, 0, height_);
+}
+
+// Update the grid based on the rules of Conway's Game of Life (or current's rule)
+void DynamicGrid::updateGrid(const DynamicGrid& current)
+{
+    const Pass pass = beginUpdate(current);
+    finishUpdate(pass, updateBand(pass, 0, height_));
+}
+
+void DynamicGrid::updateGrid(const DynamicGrid& current, const int generations)
+{
+    if (generations <= 1) {
+        updateGrid(current);
+        return;
+    }
+    boundary_ = current.boundary_;
+    rule_ = current.rule_;
+    schedule_ = current.schedule_;
+    collectStats_ = current.collectStats_;
+    hashGenerations_ = current.hashGenerations_;
+    const RowKernel kernel = rowKernel(activeSimdLevel(), wordsPerRow_, rule_);
+    const int blocks = temporalBlocks();
+    BandTotals totals;
+    for (int b = 0; b < blocks; ++b) {
+        const int begin = static_cast<int>(static_cast<long long>(b) * height_ / blocks);
+        const int end = static_cast<int>(static_cast<long long>(b + 1) * height_ / blocks);
+        const BandTotals block = updateBandBlocked(current, begin, end, generations, kernel);
+        totals.counts.births += block.counts.births;
+        totals.counts.deaths += block.counts.deaths;
+        totals.population += block.population;
+        totals.hash += block.hash;
+    }
+    finishBlockedUpdate(current, generations, totals);
+}
+
+#else // PARALLEL_GRID
+
+void DynamicGrid::runBands(void (*const thunk)(void*, int, int), void* const ctx) const
+{
+    runBandsOn(*exec_, thunk, ctx);
+}
+
+void DynamicGrid::runRenderBands(void (*const thunk)(void*, int, int), void* const ctx) const
+{
+    runBandsOn(renderExecutor(*exec_), thunk, ctx);
+}
+
+// Band t is rows [t * height / n, (t + 1) * height / n) on either pool, so a
+// render worker paints the rows its update twin wrote.
+void DynamicGrid::runBandsOn(BandExecutor& exec, void (*const thunk)(void*, int, int), void* const ctx) const
+{
+    const int n = exec.size();
+    const int rows = height_;
+    exec.run([thunk, ctx, n, rows](int t) {
+        const int begin = static_cast<int>(static_cast<long long>(t) * rows / n);
+        const int end = static_cast<int>(static_cast<long long>(t + 1) * rows / n);
+        thunk(ctx, begin, end);
+    });
+}
+
+// Parallel version of the update function: each band owns a contiguous, fixed
+// range of rows every generation, keeping its slice warm in that core's cache.
+// Under the stealing schedule the rows go out in chunks of about an eighth of a
+// band instead, each thread starting on the chunks of its own band.
+void DynamicGrid::updateGrid(const DynamicGrid& current)
+{
+    constexpr int CHUNKS_PER_BAND = 8;
+    constexpr int MIN_CHUNK_ROWS = 8;
+    const Pass pass = beginUpdate(current);
+    BandExecutor& exec = *exec_;
+    const int n = exec.size();
+    const int rows = height_;
+    // Each band sums its own rows; the bands' totals meet here once.
+    std::atomic<std::size_t> changed { 0 };
+    std::atomic<uint64_t> births { 0 };
+    std::atomic<uint64_t> deaths { 0 };
+    std::atomic<uint64_t> hash { 0 };
+    const auto update = [this, &pass, &changed, &births, &deaths, &hash](int begin, int end) {
+        const BandTotals band = updateBand(pass, begin, end);
+        changed.fetch_add(band.changedWords, std::memory_order_relaxed);
+        if (pass.counting) {
+            births.fetch_add(band.counts.births, std::memory_order_relaxed);
+            deaths.fetch_add(band.counts.deaths, std::memory_order_relaxed);
+        }
+        if (pass.hashKernel != nullptr) {
+            hash.fetch_add(band.hash, std::memory_order_relaxed);
+        }
+    };
+    if (stealing(pass.activity)) {
+        const int chunk = std::max(MIN_CHUNK_ROWS, rows / (n * CHUNKS_PER_BAND));
+        exec.runStealing(rows, chunk, [&update](int, int begin, int end) { update(begin, end); });
+    } else {
+        exec.run([&update, n, rows](int t) {
+            const int begin = static_cast<int>(static_cast<long long>(t) * rows / n);
+            const int end = static_cast<int>(static_cast<long long>(t + 1) * rows / n);
+            update(begin, end);
+        });
+    }
+    BandTotals totals;
+    totals.changedWords = changed.load(std::memory_order_relaxed);
+    totals.counts = { births.load(std::memory_order_relaxed), deaths.load(std::memory_order_relaxed) };
+    totals.hash = hash.load(std::memory_order_relaxed);
+    finishUpdate(pass, totals);
+}
+
+// Temporal blocking: `generations` generations for one pass over the pool, so
+// one barrier instead of one per generation. Band t runs blocks t, t+n, ...,
+// or under the stealing schedule its own run of blocks and then others'.
+void DynamicGrid::updateGrid(const DynamicGrid& current, const int generations)
+{
+    if (generations <= 1) {
+        updateGrid(current);
+        return;
+    }
+    boundary_ = current.boundary_;
+    rule_ = current.rule_;
+    schedule_ = current.schedule_;
+    collectStats_ = current.collectStats_;
+    hashGenerations_ = current.hashGenerations_;
+    BandExecutor& exec = *exec_;
+    const int n = exec.size();
+    const int rows = height_;
+    const int blocks = temporalBlocks();
+    const RowKernel kernel = rowKernel(activeSimdLevel(), wordsPerRow_, rule_);
+    std::atomic<uint64_t> births { 0 };
+    std::atomic<uint64_t> deaths { 0 };
+    std::atomic<uint64_t> population { 0 };
+    std::atomic<uint64_t> hash { 0 };
+    const auto update = [this, &current, &births, &deaths, &population, &hash, rows, blocks, generations, kernel](int b) {
+        const int begin = static_cast<int>(static_cast<long long>(b) * rows / blocks);
+        const int end = static_cast<int>(static_cast<long long>(b + 1) * rows / blocks);
+        const BandTotals block = updateBandBlocked(current, begin, end, generations, kernel);
+        if (collectStats_) {
+            births.fetch_add(block.counts.births, std::memory_order_relaxed);
+            deaths.fetch_add(block.counts.deaths, std::memory_order_relaxed);
+            population.fetch_add(block.population, std::memory_order_relaxed);
+        }
+        if (hashGenerations_) {
+            hash.fetch_add(block.hash, std::memory_order_relaxed);
+        }
+    };
+    // Blocking runs only while few words are stable, so Auto keeps it static.
+    if (schedule_ == Schedule::Stealing) {
+        exec.runStealing(blocks, 1, [&update](int, int begin, int end) {
+            for (int b = begin; b < end; ++b) {
+                update(b);
+            }
+        });
+    } else {
+        exec.run([&update, n, blocks](int t) {
+            for (int b = t; b < blocks; b += n) {
+                update(b);
+            }
+        });
+    }
+    BandTotals totals;
+    totals.counts = { births.load(std::memory_order_relaxed), deaths.load(std::memory_order_relaxed) };
+    totals.population = population.load(std::memory_order_relaxed);
+    totals.hash = hash.load(std::memory_order_relaxed);
+    finishBlockedUpdate(current, generations, totals);
+}
+
+#endif
+
+static std::mt19937 generator(0);
+static std::uniform_int_distribution<int> distribution(0, 2'000'000'000);
+
+// Add random noise to the grid
+void DynamicGrid::addNoise(int n)
+{
+    for (int i = 0; i < n; ++i) {
+        const int x = distribution(generator) % height_;
+        const int y = distribution(generator) % width_;
+        toggle({ x, y });
+    }
+}
+
+// Each band fills and counts its own rows. Word i of the grid (row-major) is
+// randomWord i of the seed's stream, so the bands' split does not matter.
+void DynamicGrid::randomize(const double density, const uint64_t seed)
+{
+    const uint32_t threshold = densityThreshold(density);
+    const std::size_t wpr = wordsPerRow_;
+    const uint64_t lastMask = lastWordMask_;
+    uint64_t* const words = words_.data();
+    std::atomic<uint64_t> alive { 0 };
+    forEachBand([=, &alive](int begin, int end) {
+        uint64_t count = 0;
+        for (int x = begin; x < end; ++x) {
+            const std::size_t first = static_cast<std::size_t>(x) * wpr;
+            for (std::size_t i = first; i < first + wpr; ++i) {
+                words[i] = randomWord(seed, i, threshold);
+            }
+            words[first + wpr - 1] &= lastMask;
+            for (std::size_t i = first; i < first + wpr; ++i) {
+                count += static_cast<uint64_t>(std::popcount(words[i]));
+            }
+        }
+        alive.fetch_add(count, std::memory_order_relaxed);
+    });
+    endEdits();
+    population_ = static_cast<long long>(alive.load(std::memory_order_relaxed));
+}
+
+void DynamicGrid::endEdits()
+{
+    markAllChanged();
+    stamp_ = newStamp();
+    population_ = -1;
+    statsKnown_ = false;
+}
+
+// Clear the grid
+void DynamicGrid::clear()
+{
+    std::fill(words_.begin(), words_.end(), 0ULL);
+    markAllChanged();
+    stamp_ = newStamp();
+    population_ = 0;
+    statsKnown_ = false;
+}
@@ -3,60 +3,115 @@
 
 #pragma once
 
-#include <array>
+#include "AlignedAllocator.hpp"
+#include "BandStats.hpp"
+#include "Rule.hpp"
+#include "SimdKernels.hpp"
+
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
-#include <random>
-
-#if 1 // Enable multithreaded calculation of grid updates
-#define PARALLEL_GRID 1
-#include "BandExecutor.hpp"
-
-#include <algorithm> // std::max
-#include <cstdlib> // std::getenv, std::atoi
-#include <thread> // std::thread::hardware_concurrency
-
-// Worker count for a grid of `rows` rows. GOL_THREADS overrides everything; else
-// use up to half the hardware threads, but keep each band at least
-// MIN_ROWS_PER_BAND rows so the per-generation barrier + halo-coherence cost stays
-// amortized. Over-threading a small grid is a net loss: at 512x512, 16 bands run
-// ~3x slower than 4, because the tiny per-band work can't hide the sync overhead.
-static int gridThreadsForRows(int rows)
-{
-    if (const char* env = std::getenv("GOL_THREADS")) {
-        const int n = std::atoi(env);
-        if (n > 0) {
-            return n;
-        }
-    }
-    constexpr int MIN_ROWS_PER_BAND = 128;
-    const int byHardware = static_cast<int>(std::max(1u, std::thread::hardware_concurrency() / 2));
-    const int byWork = std::max(1, rows / MIN_ROWS_PER_BAND);
-    return std::min(byHardware, byWork);
-}
-
-// One persistent worker pool per grid size, sized for that size on first use.
-template <int SIZE>
-static BandExecutor& gridExecutor()
-{
-    static BandExecutor exec { gridThreadsForRows(SIZE) };
-    return exec;
-}
-#endif
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+class BandExecutor;
 
 struct Point {
     const int x;
     const int y;
 };
 
+// What lies past the grid's edges.
+enum class Boundary {
+    Dead, // every cell outside is dead (the classic bounded grid)
+    Torus, // edges wrap around: row -1 is row height-1, column -1 is width-1
+    Reflect, // edges mirror: the cell outside an edge copies the edge cell
+    Alive, // every cell outside is permanently alive
+};
+
+// A generation's population, and the births and deaths that produced it from the
+// one before.
+struct GenerationStats {
+    long long population = 0;
+    long long births = 0;
+    long long deaths = 0;
+};
+
+// "dead", "torus", "reflect" or "alive".
+const char* boundaryName(Boundary boundary);
+bool parseBoundary(const char* text, Boundary& boundary);
+
+// How updateGrid hands rows to its worker threads.
+enum class Schedule {
+    Auto, // Stealing while activity tracking skips stable words, else Static
+    Static, // one fixed band of rows per thread, the same every generation
+    Stealing, // smaller chunks; threads done with their own take others'
+};
+
+// "auto", "static" or "stealing".
+const char* scheduleName(Schedule schedule);
+bool parseSchedule(const char* text, Schedule& schedule);
+
+// Cores to pin the update threads to (see BandExecutor): worker t of a pool
+// runs on cores[t % cores.size()], leaving cores[0] for the thread that calls
+// updateGrid. Empty (unpinned) unless GOL_PIN holds a CPU list such as "0-15".
+// Applies to grids created, or given setThreads, afterwards.
+const std::vector<int>& workerCores();
+void setWorkerCores(const std::vector<int>& cores);
+// How long idle update threads spin before parking: 50 us unless GOL_SPIN_US
+// says otherwise. Long enough to bridge the gap between a small grid's
+// generations; pools with more threads than the hardware runs park at once.
+// Applies to existing pools too.
+std::chrono::microseconds barrierSpin();
+void setBarrierSpin(std::chrono::microseconds spin);
+
 // Bit-packed grid: one bit per cell, 64 cells per 64-bit word. Cell (x, y) lives
 // in word row x, at bit (y & 63) of word (y >> 6). Packing the grid 8x tighter
 // than one byte/cell both shrinks the working set (more of it stays in cache) and
 // lets updateGrid evaluate 64 cells at once with SWAR bitwise arithmetic.
-template <int SIZE>
-class alignas(64) Grid {
-    static_assert(SIZE % 64 == 0, "bit-packed Grid requires SIZE to be a multiple of 64");
-
+// The grid is width columns (y) by height rows (x), both chosen at runtime, and
+// the words live on the heap; the row kernels are still specialized at compile
+// time for the common power-of-two widths. When width is not a multiple of 64
+// the last word of each row is partial: its bits past the edge are always zero.
+class DynamicGrid {
 public:
+    DynamicGrid(int width, int height);
+    explicit DynamicGrid(int size)
+        : DynamicGrid(size, size)
+    {
+    }
+
+    int width() const { return width_; }
+    int height() const { return height_; }
+
+    // Boundary mode, Dead by default. updateGrid adopts the source grid's mode,
+    // so setting it on the grid being stepped from is enough.
+    Boundary boundary() const { return boundary_; }
+    void setBoundary(Boundary boundary)
+    {
+        boundary_ = boundary;
+        markAllChanged();
+    }
+
+    // Life-like rule, Conway's B3/S23 by default. Like the boundary mode,
+    // updateGrid takes it from the source grid.
+    const Rule& rule() const { return rule_; }
+    void setRule(const Rule& rule)
+    {
+        rule_ = rule;
+        markAllChanged();
+    }
+
+    // How updateGrid splits rows among the threads, Auto by default. Static
+    // bands keep each thread on the same rows, but when the live cells sit in a
+    // few bands (a glider gun in an empty field) the other threads idle at the
+    // barrier; stealing evens that out at some cost in locality. Auto steals
+    // only while updates skip stable words, which is when the work is uneven.
+    // Like the rule, updateGrid takes it from the source grid.
+    Schedule schedule() const { return schedule_; }
+    void setSchedule(Schedule schedule) { schedule_ = schedule; }
+
     inline bool get(const Point& p) const
     {
         return (words_[wordIndex(p)] >> bitOffset(p)) & 1ULL;
@@ -65,178 +120,253 @@ public:
     {
         const uint64_t mask = 1ULL << bitOffset(p);
         uint64_t& w = words_[wordIndex(p)];
+        const bool was = (w & mask) != 0;
         w = value ? (w | mask) : (w & ~mask);
+        markChanged(p, static_cast<int>(value) - static_cast<int>(was));
     }
     inline void toggle(const Point& p)
     {
-        words_[wordIndex(p)] ^= 1ULL << bitOffset(p);
+        uint64_t& w = words_[wordIndex(p)];
+        w ^= 1ULL << bitOffset(p);
+        markChanged(p, ((w >> bitOffset(p)) & 1ULL) != 0 ? 1 : -1);
+    }
+
+    // Fused statistics. While on, updateGrid has the row kernel popcount births
+    // and deaths from the words it already holds in registers, sums them per
+    // band, and keeps the population current from them, so reading them costs
+    // nothing. Like the rule, updateGrid takes the setting from the source grid.
+    // Off by default: counting adds a few vector ops per word.
+    bool collectsStats() const { return collectStats_; }
+    void setCollectStats(bool collect) { collectStats_ = collect; }
+    // Live cells: O(1) after a stats-collecting update and through set, toggle
+    // and clear; otherwise one popcount pass over the words.
+    long long population() const;
+    // The last updateGrid's births and deaths with the resulting population,
+    // unless it did not collect stats or a cell has been edited since.
+    std::optional<GenerationStats> stats() const;
+    // Fused hashing. While on, updateGrid hashes each row right after writing
+    // it (a skipped row keeps the hash it had), so contentHash() of the result
+    // costs nothing; for spotting when a soup has settled into a cycle. Like
+    // the rule, updateGrid takes the setting from the source grid. Off by
+    // default: it adds a few vector ops per word.
+    bool hashesGenerations() const { return hashGenerations_; }
+    void setHashGenerations(bool hash) { hashGenerations_ = hash; }
+    // A 64-bit hash of the cells, equal for equal contents whatever the thread
+    // count or update path: O(1) after a hashing update, else one pass over
+    // the words.
+    uint64_t contentHash() const;
+    // Whether word `word` of row x (cells 64*word .. 64*word+63) differs from
+    // its value two generations back, or was edited since. Only meaningful
+    // while updateGrid tracks activity: it recomputes just the words with a
+    // changed word among their eight neighbors or themselves.
+    bool wordChanged(int x, int word) const
+    {
+        return (changed_[(static_cast<std::size_t>(x) * changedStride_) + (word >> 6)] >> (word & 63)) & 1ULL;
     }
     int countLiveNeighbors(const Point& p) const;
+    // Word row x: wordsPerRow() words, cell (x, y) at bit (y & 63) of word y >> 6.
+    int wordsPerRow() const { return wordsPerRow_; }
+    const uint64_t* row(int x) const { return words_.data() + (static_cast<std::size_t>(x) * wordsPerRow_); }
+    // Bulk edits (pattern loaders) write words directly: rowForEdit(x) is row x,
+    // writable, and its bits past the right edge must stay zero. Call endEdits()
+    // once done, before stepping or asking for the population.
+    uint64_t* rowForEdit(int x) { return words_.data() + (static_cast<std::size_t>(x) * wordsPerRow_); }
+    void endEdits();
+    // countLiveNeighbors for all of row x at once, through the update's adder
+    // network: planes gets the four bit-planes described at NeighborKernel, so
+    // it must hold 4 * wordsPerRow() words. Bits past the right edge are zero.
+    void neighborPlanes(int x, uint64_t* planes) const;
+    // Call fn(begin, end) for each band of rows [begin, end) that updateGrid
+    // splits the grid into, on the worker thread that updates it, and return
+    // once all are done. For read-only passes such as rendering, which then find
+    // their rows in the cache of the core that just wrote them.
+    template <typename F>
+    void forEachBand(F&& fn) const
+    {
+        runBands([](void* p, int begin, int end) { (*static_cast<std::remove_reference_t<F>*>(p))(begin, end); }, &fn);
+    }
+    // forEachBand for read-only passes from a thread other than the one that
+    // steps the grid, such as a GUI's render thread. They run on a second pool
+    // with the same bands, its worker t pinned to the core of the update pool's
+    // worker t, so band t still finds its rows in that core's cache; neither
+    // pool waits for the other, so a slow frame never holds up updateGrid.
+    template <typename F>
+    void forEachRenderBand(F&& fn) const
+    {
+        runRenderBands([](void* p, int begin, int end) { (*static_cast<std::remove_reference_t<F>*>(p))(begin, end); }, &fn);
+    }
+    // Worker threads that update this grid, one band of rows each (updateGrid
+    // uses the destination grid's). setThreads(0) restores the default:
+    // GOL_THREADS if set, else a count picked from the hardware and the height.
+    // Each band's rows are first written by the thread that updates them, so
+    // with pinned workers they live on its NUMA node; a new thread count or
+    // core list moves them there too.
+    int threads() const { return bandCount(); }
+    void setThreads(int threads);
+    // Timings of the passes on this grid's worker pool (its updates, and those
+    // of any grid sharing the pool, and forEachBand calls, but not render
+    // passes) since the last reset. Empty unless built with GOL_BAND_STATS.
+    BandStats bandStats() const;
+    void resetBandStats() const;
     void toggleBlock(const Point& p);
-    void updateGrid(const Grid<SIZE>& current);
+    void updateGrid(const DynamicGrid& current);
+    // Make this grid current advanced `generations` generations in one pass
+    // (temporal blocking): each block of rows steps a private copy widened by a
+    // halo of `generations` rows, so the worker bands sync once per call instead
+    // of once per generation. Same result as that many single updateGrid calls.
+    void updateGrid(const DynamicGrid& current, int generations);
+    // A good `generations` for the call above, picked from the grid size, band
+    // count and recent activity; 1 when blocking would not pay off. Worth
+    // asking again as the grid evolves.
+    int generationsPerUpdate() const;
+    // Toggle n cells picked at random (repeats included).
     void addNoise(int n = 1);
+    // Replace the contents with random cells, each alive with probability
+    // `density` (to 1/65536). Counter-based (see randomWord), filled band by
+    // band on the update threads: the same seed gives the same grid whatever
+    // the thread count.
+    void randomize(double density, uint64_t seed);
     void clear();
 
 private:
-    static constexpr int WORDS_PER_ROW = SIZE / 64;
-    alignas(64) std::array<uint64_t, SIZE * WORDS_PER_ROW> words_ {};
+    int width_;
+    int height_;
+    int wordsPerRow_;
+    uint64_t lastWordMask_; // valid bits of each row's last word
+    Boundary boundary_ = Boundary::Dead;
+    Rule rule_;
+    Schedule schedule_ = Schedule::Auto;
+    BandExecutor* exec_ = nullptr; // shared worker pool for this many rows
+    std::vector<uint64_t, AlignedAllocator<uint64_t>> words_;
+    // Activity tracking: bit w of row x's changedStride_ words is set when word w
+    // of row x differs from two generations back (or was edited since). A word
+    // whose 3x3 block of neighboring words did not change repeats the previous
+    // generation's value next.
+    // The bits mean something only while changedKnown_; changedWords_ counts
+    // them and untracked_ counts generations since they were last recorded.
+    int changedStride_;
+    std::vector<uint64_t> changed_;
+    std::vector<uint8_t> rowChanged_; // row x has a change bit set; a byte so bands never share a word
+    bool changedKnown_ = true;
+    std::size_t changedWords_ = 0;
+    int untracked_ = 0;
+    // Identifies the contents: a fresh value after every whole-grid operation,
+    // 0 once single cells are edited. sourceStamp_ is the stamp of the grid this
+    // one was computed from; when that grid is the destination of the next step
+    // it still holds the previous generation, so unchanged rows are left there.
+    uint64_t stamp_ = 0;
+    uint64_t sourceStamp_ = 0;
+    // Fused statistics (see stats()); population_ is -1 while unknown.
+    // rowCounts_ holds each row's births and deaths, summing to births_ and
+    // deaths_, while rowCountsKnown_: after a pass that counted and tracked.
+    bool collectStats_ = false;
+    bool statsKnown_ = false;
+    bool rowCountsKnown_ = false;
+    std::vector<RowCounts> rowCounts_;
+    long long population_ = 0;
+    long long births_ = 0;
+    long long deaths_ = 0;
+    // Fused hashing (see contentHash()): contentHash_ and each row's share in
+    // rowHashes_ describe the contents while hashStamp_ equals stamp_.
+    bool hashGenerations_ = false;
+    uint64_t hashStamp_ = 0;
+    uint64_t contentHash_ = 0;
+    std::vector<uint64_t> rowHashes_;
+    // Stand in for the missing row above/below the grid's top/bottom edge.
+    std::vector<uint64_t, AlignedAllocator<uint64_t>> zeroRow_;
+    std::vector<uint64_t, AlignedAllocator<uint64_t>> onesRow_;
 
-    inline void updateRow(const Grid<SIZE>& current, int x);
-    inline static int wordIndex(const Point& p) { return (p.x * WORDS_PER_ROW) + (p.y >> 6); }
-    inline static int bitOffset(const Point& p) { return p.y & 63; }
-};
+    enum class Activity {
+        Off, // compute every word, keep no change bits
+        Record, // compute every word, record change bits
+        Skip, // compute only words next to a change, record change bits
+    };
+    // What one updateGrid pass does, shared by all bands.
+    struct Pass {
+        const DynamicGrid& current;
+        RowKernel kernel;
+        RowKernel spanKernel; // runtime-width kernel for runs of dirty words
+        CountKernel countKernel; // births and deaths of rows that skipped words
+        Activity activity;
+        bool counting; // collect births and deaths
+        bool countDelta; // count them as changes to this grid's last counts
+        HashKernel hashKernel; // hashes the rows written, unless null
+        bool rowHashesKnown; // skipped rows still have their hash in rowHashes_
+    };
+    // What a band reports back; population only from temporal blocking, hash
+    // (its rows' sum of rowHashes_) only from hashing passes.
+    struct BandTotals {
+        std::size_t changedWords = 0;
+        RowCounts counts;
+        uint64_t population = 0;
+        uint64_t hash = 0;
+    };
 
-// Count the number of live neighbors for the cell at (x, y). Used only for
-// rendering (cell coloring), so bit extraction with bounds checks is plenty.
-template <int SIZE>
-int Grid<SIZE>::countLiveNeighbors(const Point& p) const
-{
-    int liveNeighbors = 0;
-    for (int i = -1; i <= 1; ++i) {
-        for (int j = -1; j <= 1; ++j) {
-            if (i == 0 && j == 0)
-                continue; // Skip the cell itself
-            const int nx = p.x + i;
-            const int ny = p.y + j;
-            if (nx >= 0 && nx < SIZE && ny >= 0 && ny < SIZE) {
-                liveNeighbors += get({ nx, ny }) ? 1 : 0;
-            }
-        }
-    }
-    return liveNeighbors;
-}
-
-// Toggle a 3x3 block of cells at the given position
-template <int SIZE>
-void Grid<SIZE>::toggleBlock(const Point& p)
-{
-    const int size = 1;
-    for (int i = -size; i <= size; ++i) {
-        for (int j = -size; j <= size; ++j) {
-            const Point n { p.x + i, p.y + j };
-            if (n.x >= 0 && n.x < SIZE && n.y >= 0 && n.y < SIZE) {
-                toggle(n);
-            }
+    void runBands(void (*thunk)(void*, int, int), void* ctx) const;
+    void runRenderBands(void (*thunk)(void*, int, int), void* ctx) const;
+    void runBandsOn(BandExecutor& exec, void (*thunk)(void*, int, int), void* ctx) const;
+    void placeRows(const uint64_t* from, uint64_t* to) const;
+    Pass beginUpdate(const DynamicGrid& current);
+    void finishUpdate(const Pass& pass, const BandTotals& totals);
+    BandTotals updateBand(const Pass& pass, int begin, int end);
+    template <Boundary B>
+    BandTotals updateRows(const Pass& pass, int begin, int end);
+    template <Boundary B>
+    inline void updateRow(const DynamicGrid& current, int x, RowKernel kernel, uint64_t* changed, RowCounts* counts);
+    template <Boundary B>
+    inline void updateActiveRow(const Pass& pass, int x, uint64_t* dirty, uint64_t* prev, RowCounts* counts);
+    void redoEdgeChanges(uint64_t* changed, uint64_t first, uint64_t last, const uint64_t* out) const;
+    void countEdgeWords(RowCounts& counts, const uint64_t* mid, const uint64_t* out, int sign) const;
+    void countSkippedRow(const Pass& pass, int x, RowCounts& counts);
+    template <Boundary B>
+    inline const uint64_t* rowAbove(const uint64_t* cur, int x) const;
+    template <Boundary B>
+    inline const uint64_t* rowBelow(const uint64_t* cur, int x) const;
+    BandTotals updateBandBlocked(const DynamicGrid& current, int begin, int end, int generations, RowKernel kernel);
+    template <Boundary B>
+    BandTotals updateRowsBlocked(const DynamicGrid& current, int begin, int end, int generations, RowKernel kernel);
+    void finishBlockedUpdate(const DynamicGrid& current, int generations, const BandTotals& totals);
+    template <Boundary B>
+    inline void evalRow(const uint64_t* top, const uint64_t* mid, const uint64_t* bot, uint64_t* out, RowKernel kernel, uint64_t* changed, RowCounts* counts) const;
+    template <Boundary B>
+    inline const uint64_t* outsideRow(const uint64_t* edge) const;
+    template <Boundary B>
+    void neighborPlanesOf(int x, uint64_t* planes) const;
+    int bandCount() const;
+    int temporalBlocks() const;
+    // Whether a pass with this activity tracking hands out rows by stealing.
+    bool stealing(Activity activity) const { return schedule_ == Schedule::Stealing || (schedule_ == Schedule::Auto && activity == Activity::Skip); }
+    template <Boundary B>
+    void fixEdgeCells(const uint64_t* top, const uint64_t* mid, const uint64_t* bot, uint64_t* out) const;
+    bool cellOrBoundary(int x, int y) const;
+    uint64_t hashRow(int x, HashKernel kernel) const;
+    bool hashKnown() const { return stamp_ != 0 && hashStamp_ == stamp_; }
+    void markAllChanged();
+    // A cell edit: its word counts as changed and the population moves by delta.
+    inline void markChanged(const Point& p, const int delta)
+    {
+        changed_[(static_cast<std::size_t>(p.x) * changedStride_) + (p.y >> 12)] |= 1ULL << ((p.y >> 6) & 63);
+        rowChanged_[p.x] = 1;
+        stamp_ = 0;
+        statsKnown_ = false;
+        if (population_ >= 0) {
+            population_ += delta;
         }
     }
-}
-
-// Update one row using SWAR: 64 cells per word are evaluated with pure bitwise
-// arithmetic. For the three source rows we build, per column, the sum of its 8
-// neighbors via full/half adders on bit-planes, keeping the low 3 bits s0,s1,s2
-// of that 0..8 count. Conway's rule then collapses to a single expression:
-//   next = s1 & ~s2 & (s0 | self)
-// i.e. alive next iff neighbor count is 2 (and self alive) or exactly 3.
-// Grid edges are non-toroidal: zeros shift in past the first/last word and past
-// the top/bottom rows, so out-of-bounds neighbors read as dead automatically.
-template <int SIZE>
-inline void Grid<SIZE>::updateRow(const Grid<SIZE>& current, const int x)
-{
-    constexpr int WPR = WORDS_PER_ROW;
-    const uint64_t* const __restrict cur = current.words_.data();
-    uint64_t* const __restrict out = words_.data();
-
-    const int midBase = x * WPR;
-    const bool hasTop = x > 0;
-    const bool hasBot = x < SIZE - 1;
-    const int topBase = midBase - WPR;
-    const int botBase = midBase + WPR;
-
-    for (int w = 0; w < WPR; ++w) {
-        // Center words for the three rows (0 past the top/bottom edges).
-        const uint64_t aC = hasTop ? cur[topBase + w] : 0;
-        const uint64_t bC = cur[midBase + w];
-        const uint64_t cC = hasBot ? cur[botBase + w] : 0;
-
-        // Adjacent words feed the bit that crosses a 64-cell boundary; 0 at the
-        // left/right grid edge so past-the-edge columns read as dead.
-        const bool hasPrev = w > 0;
-        const bool hasNext = w < WPR - 1;
-        const uint64_t aP = (hasTop && hasPrev) ? cur[topBase + w - 1] : 0;
-        const uint64_t aN = (hasTop && hasNext) ? cur[topBase + w + 1] : 0;
-        const uint64_t bP = hasPrev ? cur[midBase + w - 1] : 0;
-        const uint64_t bN = hasNext ? cur[midBase + w + 1] : 0;
-        const uint64_t cP = (hasBot && hasPrev) ? cur[botBase + w - 1] : 0;
-        const uint64_t cN = (hasBot && hasNext) ? cur[botBase + w + 1] : 0;
-
-        // Left/right neighbor bit-planes for each row.
-        const uint64_t aL = (aC << 1) | (aP >> 63);
-        const uint64_t aR = (aC >> 1) | (aN << 63);
-        const uint64_t bL = (bC << 1) | (bP >> 63);
-        const uint64_t bR = (bC >> 1) | (bN << 63);
-        const uint64_t cL = (cC << 1) | (cP >> 63);
-        const uint64_t cR = (cC >> 1) | (cN << 63);
-
-        // Top row: sum of its 3 columns -> 2-bit value (t1 t0).
-        const uint64_t t0 = aL ^ aC ^ aR;
-        const uint64_t t1 = (aL & aC) | (aC & aR) | (aL & aR);
-        // Bottom row: sum of its 3 columns -> (u1 u0).
-        const uint64_t u0 = cL ^ cC ^ cR;
-        const uint64_t u1 = (cL & cC) | (cC & cR) | (cL & cR);
-        // Middle row: left + right only (self excluded) -> (v1 v0).
-        const uint64_t v0 = bL ^ bR;
-        const uint64_t v1 = bL & bR;
-
-        // Add the three 2-bit numbers; keep the low 3 bits of the 0..8 total.
-        const uint64_t s0 = t0 ^ u0 ^ v0;
-        const uint64_t c0 = (t0 & u0) | (u0 & v0) | (t0 & v0);
-        const uint64_t hs = t1 ^ u1 ^ v1;
-        const uint64_t hc = (t1 & u1) | (u1 & v1) | (t1 & v1);
-        const uint64_t s1 = hs ^ c0;
-        const uint64_t s2 = hc ^ (hs & c0);
-
-        out[midBase + w] = s1 & ~s2 & (s0 | bC);
-    }
-}
+    uint64_t* changedRow(int x) { return changed_.data() + (static_cast<std::size_t>(x) * changedStride_); }
+    const uint64_t* changedRow(int x) const { return changed_.data() + (static_cast<std::size_t>(x) * changedStride_); }
+    inline int wordIndex(const Point& p) const { return (p.x * wordsPerRow_) + (p.y >> 6); }
+    inline static int bitOffset(const Point& p) { return p.y & 63; }
+};
 
-#ifndef PARALLEL_GRID
+// Fixed-size grid for code that knows its size at compile time (tests, tools).
+template <int WIDTH, int HEIGHT = WIDTH>
+class Grid : public DynamicGrid {
+    static_assert(WIDTH > 0 && HEIGHT > 0, "Grid dimensions must be positive");
 
-// Update the grid based on the rules of Conway's Game of Life
-template <int SIZE>
-void Grid<SIZE>::updateGrid(const Grid<SIZE>& current)
-{
-    for (int x = 0; x < SIZE; ++x) {
-        updateRow(current, x);
-    }
-}
-
-#else // PARALLEL_GRID
-
-// Parallel version of the update function: each band owns a contiguous, fixed
-// range of rows every generation, keeping its slice warm in that core's cache.
-template <int SIZE>
-void Grid<SIZE>::updateGrid(const Grid<SIZE>& current)
-{
-    BandExecutor& exec = gridExecutor<SIZE>();
-    const int n = exec.size();
-    exec.run([this, &current, n](int t) {
-        const int begin = static_cast<int>(static_cast<long long>(t) * SIZE / n);
-        const int end = static_cast<int>(static_cast<long long>(t + 1) * SIZE / n);
-        for (int x = begin; x < end; ++x) {
-            updateRow(current, x);
-        }
-    });
-}
-
-#endif
-
-static std::mt19937 generator(0);
-static std::uniform_int_distribution<int> distribution(0, 2'000'000'000);
-
-// Add random noise to the grid
-template <int SIZE>
-void Grid<SIZE>::addNoise(int n)
-{
-    for (int i = 0; i < n; ++i) {
-        const int x = distribution(generator) % SIZE;
-        const int y = distribution(generator) % SIZE;
-        toggle({ x, y });
+public:
+    Grid()
+        : DynamicGrid(WIDTH, HEIGHT)
+    {
     }
-}
-
-// Clear the grid
-template <int SIZE>
-void Grid<SIZE>::clear()
-{
-    words_.fill(0ULL);
-}
+};
@@ -0,0 +1,518 @@
+// Conway's Game of Life
+// Copyright (c) 2025 Faraz Fallahi <fffaraz@gmail.com>
+
+#include "HashLife.hpp"
+#include "Grid.hpp"
+#include "SwarKernel.hpp"
+
+#include <algorithm>
+#include <bit> // std::popcount
+#include <stdexcept>
+#include <unordered_map>
+
+namespace {
+
+// Deepest quadtree the 64-bit coordinates can address.
+constexpr int MAX_LEVEL = 62;
+
+// splitmix64's finalizer.
+uint64_t mix(uint64_t h)
+{
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+uint64_t nodeHash(int level, uint64_t a, uint64_t b)
+{
+    return mix(a ^ mix(b + static_cast<uint64_t>(level)));
+}
+
+// Row r (8 cells) of a leaf.
+uint64_t leafRow(uint64_t cells, int r)
+{
+    return (cells >> (8 * r)) & 0xFF;
+}
+
+} // namespace
+
+HashLife::HashLife(const Rule& rule, std::size_t memoryBudget)
+    : rule_(rule)
+    , memoryBudget_(memoryBudget)
+    , maxNodes_(std::clamp<std::size_t>(memoryBudget / (sizeof(Node) + 2 * sizeof(NodeId)), 4096, NONE - 1))
+{
+    if (rule.birth & 1) {
+        throw std::invalid_argument("HashLife cannot run B0 rules");
+    }
+    buckets_.assign(1024, NONE);
+    clear();
+}
+
+std::size_t HashLife::memoryUsage() const
+{
+    return (nodes_.capacity() * sizeof(Node)) + (buckets_.capacity() * sizeof(NodeId));
+}
+
+// The node with these contents, created if it does not exist yet.
+HashLife::NodeId HashLife::intern(int level, uint64_t a, uint64_t b)
+{
+    const uint64_t h = nodeHash(level, a, b);
+    for (NodeId id = buckets_[h & (buckets_.size() - 1)]; id != NONE; id = nodes_[id].next) {
+        const Node& n = nodes_[id];
+        if (n.a == a && n.b == b && n.level == level) {
+            return id;
+        }
+    }
+    // A collection inside allocate() must not free the new node's children.
+    const std::size_t base = pins_.size();
+    if (level > LEAF_LEVEL) {
+        pins_.insert(pins_.end(), { static_cast<NodeId>(a), static_cast<NodeId>(a >> 32), static_cast<NodeId>(b), static_cast<NodeId>(b >> 32) });
+    }
+    const NodeId id = allocate();
+    pins_.resize(base);
+    NodeId& head = buckets_[h & (buckets_.size() - 1)];
+    nodes_[id] = Node { a, b, NONE, head, static_cast<uint8_t>(level), false };
+    head = id;
+    return id;
+}
+
+HashLife::NodeId HashLife::join(NodeId nw, NodeId ne, NodeId sw, NodeId se)
+{
+    return intern(nodes_[nw].level + 1, nw | (uint64_t { ne } << 32), sw | (uint64_t { se } << 32));
+}
+
+HashLife::NodeId HashLife::empty(int level)
+{
+    while (static_cast<int>(empty_.size()) <= level - LEAF_LEVEL) {
+        const NodeId e = empty_.empty() ? leaf(0) : join(empty_.back(), empty_.back(), empty_.back(), empty_.back());
+        empty_.push_back(e);
+    }
+    return empty_[level - LEAF_LEVEL];
+}
+
+bool HashLife::isEmpty(NodeId id) const
+{
+    const int i = nodes_[id].level - LEAF_LEVEL;
+    return i < static_cast<int>(empty_.size()) && empty_[i] == id;
+}
+
+// Keep an intermediate node alive until the enclosing step unwinds its pins.
+HashLife::NodeId HashLife::pin(NodeId id)
+{
+    pins_.push_back(id);
+    return id;
+}
+
+// A free node slot. Once the pool holds maxNodes_ nodes, collect garbage first:
+// keeping memoized results if that frees a useful amount, else dropping them.
+HashLife::NodeId HashLife::allocate()
+{
+    if (freeList_ == NONE && nodes_.size() >= maxNodes_) {
+        collect(false);
+        if (freeCount_ < maxNodes_ / 4) {
+            collect(true);
+        }
+        if (freeList_ == NONE) {
+            throw std::length_error("HashLife memory budget exhausted");
+        }
+    }
+    if (freeList_ != NONE) {
+        const NodeId id = freeList_;
+        freeList_ = nodes_[id].next;
+        --freeCount_;
+        return id;
+    }
+    if (nodes_.size() == nodes_.capacity()) {
+        nodes_.reserve(std::min(maxNodes_, std::max<std::size_t>(4096, nodes_.capacity() * 2)));
+    }
+    nodes_.push_back({});
+    if (nodes_.size() > buckets_.size()) {
+        growBuckets();
+    }
+    return static_cast<NodeId>(nodes_.size() - 1);
+}
+
+void HashLife::growBuckets()
+{
+    std::vector<NodeId> buckets(buckets_.size() * 2, NONE);
+    for (NodeId head : buckets_) {
+        while (head != NONE) {
+            Node& n = nodes_[head];
+            const NodeId next = n.next;
+            NodeId& slot = buckets[nodeHash(n.level, n.a, n.b) & (buckets.size() - 1)];
+            n.next = slot;
+            slot = head;
+            head = next;
+        }
+    }
+    buckets_.swap(buckets);
+}
+
+void HashLife::mark(NodeId id, bool followResults)
+{
+    Node& n = nodes_[id];
+    if (n.marked) {
+        return;
+    }
+    n.marked = true;
+    const NodeId result = n.result;
+    if (n.level > LEAF_LEVEL) {
+        const NodeId kids[4] = { nw(n), ne(n), sw(n), se(n) };
+        for (NodeId kid : kids) {
+            mark(kid, followResults);
+        }
+    }
+    if (followResults && result != NONE) {
+        mark(result, followResults);
+    }
+}
+
+// Mark everything reachable from the universe, the canonical empty nodes and the
+// running step's pins, then rebuild the hash chains from the survivors and put
+// the rest on the free list.
+void HashLife::collect(bool dropResults)
+{
+    ++collections_;
+    if (dropResults) {
+        for (Node& n : nodes_) {
+            n.result = NONE;
+        }
+    }
+    mark(root_, !dropResults);
+    for (NodeId id : empty_) {
+        mark(id, !dropResults);
+    }
+    for (NodeId id : pins_) {
+        mark(id, !dropResults);
+    }
+
+    std::fill(buckets_.begin(), buckets_.end(), NONE);
+    freeList_ = NONE;
+    freeCount_ = 0;
+    for (std::size_t i = nodes_.size(); i-- > 0;) {
+        Node& n = nodes_[i];
+        const NodeId id = static_cast<NodeId>(i);
+        if (n.marked) {
+            n.marked = false;
+            NodeId& slot = buckets_[nodeHash(n.level, n.a, n.b) & (buckets_.size() - 1)];
+            n.next = slot;
+            slot = id;
+        } else {
+            n = Node { 0, 0, NONE, freeList_, 0, false };
+            freeList_ = id;
+            ++freeCount_;
+        }
+    }
+}
+
+// A node's memoized result advances 2^min(stepLog, level-2) generations, so
+// switching step size only invalidates the levels where that changes.
+void HashLife::setStepLog(int stepLog)
+{
+    if (stepLog == stepLog_) {
+        return;
+    }
+    const int keep = std::min(stepLog, stepLog_) + 2;
+    for (Node& n : nodes_) {
+        if (n.level > keep) {
+            n.result = NONE;
+        }
+    }
+    stepLog_ = stepLog;
+}
+
+// The centered half-size block of a level >= 4 node.
+HashLife::NodeId HashLife::center(NodeId id)
+{
+    const Node n = nodes_[id];
+    const Node a = nodes_[nw(n)];
+    const Node b = nodes_[ne(n)];
+    const Node c = nodes_[sw(n)];
+    const Node d = nodes_[se(n)];
+    if (n.level > LEAF_LEVEL + 1) {
+        return join(se(a), sw(b), ne(c), nw(d));
+    }
+    uint64_t cells = 0;
+    for (int r = 0; r < 4; ++r) {
+        cells |= ((leafRow(a.a, r + 4) >> 4) | ((leafRow(b.a, r + 4) & 0xF) << 4)) << (8 * r);
+        cells |= ((leafRow(c.a, r) >> 4) | ((leafRow(d.a, r) & 0xF) << 4)) << (8 * (r + 4));
+    }
+    return leaf(cells);
+}
+
+// Base case: the center 8x8 of a 16x16 node, run 1, 2 or 4 generations with
+// the scalar SWAR kernel (one 16-cell row per word).
+HashLife::NodeId HashLife::advanceLeaves(NodeId id)
+{
+    const Node n = nodes_[id];
+    const uint64_t a = nodes_[nw(n)].a;
+    const uint64_t b = nodes_[ne(n)].a;
+    const uint64_t c = nodes_[sw(n)].a;
+    const uint64_t d = nodes_[se(n)].a;
+    uint64_t rows[16];
+    for (int r = 0; r < 8; ++r) {
+        rows[r] = leafRow(a, r) | (leafRow(b, r) << 8);
+        rows[r + 8] = leafRow(c, r) | (leafRow(d, r) << 8);
+    }
+
+    const GenericRule::Eval<WordOps> eval(rule_);
+    const int generations = 1 << std::min(stepLog_, 2);
+    for (int g = 0; g < generations; ++g) {
+        uint64_t next[16];
+        for (int r = 0; r < 16; ++r) {
+            const uint64_t above = r > 0 ? rows[r - 1] : 0;
+            const uint64_t below = r < 15 ? rows[r + 1] : 0;
+            next[r] = lifeStep<WordOps>(0, above, 0, 0, rows[r], 0, 0, below, 0, eval) & 0xFFFF;
+        }
+        std::copy(next, next + 16, rows);
+    }
+
+    uint64_t cells = 0;
+    for (int r = 0; r < 8; ++r) {
+        cells |= ((rows[r + 4] >> 4) & 0xFF) << (8 * r);
+    }
+    return leaf(cells);
+}
+
+// The memoized result of a level >= 4 node. From the node's nine overlapping
+// half-size blocks, form four quarter-size blocks one time step in, then step
+// those again. When the step covers the node's full reach (2^(level-2)) both
+// halves advance; for smaller steps the first half only re-centers.
+HashLife::NodeId HashLife::advance(NodeId id)
+{
+    if (nodes_[id].result != NONE) {
+        return nodes_[id].result;
+    }
+    const int level = nodes_[id].level;
+    NodeId result;
+    if (isEmpty(id)) {
+        result = empty(level - 1);
+    } else if (level == LEAF_LEVEL + 1) {
+        result = advanceLeaves(id);
+    } else {
+        const std::size_t base = pins_.size();
+        pin(id);
+        const Node n = nodes_[id];
+        const Node a = nodes_[nw(n)];
+        const Node b = nodes_[ne(n)];
+        const Node c = nodes_[sw(n)];
+        const Node d = nodes_[se(n)];
+        NodeId m[9] = {
+            nw(n), pin(join(ne(a), nw(b), se(a), sw(b))), ne(n),
+            pin(join(sw(a), se(a), nw(c), ne(c))), pin(join(se(a), sw(b), ne(c), nw(d))), pin(join(sw(b), se(b), nw(d), ne(d))),
+            sw(n), pin(join(ne(c), nw(d), se(c), sw(d))), se(n)
+        };
+        const bool full = stepLog_ >= level - 2;
+        for (NodeId& block : m) {
+            block = pin(full ? advance(block) : center(block));
+        }
+        const NodeId q0 = pin(advance(pin(join(m[0], m[1], m[3], m[4]))));
+        const NodeId q1 = pin(advance(pin(join(m[1], m[2], m[4], m[5]))));
+        const NodeId q2 = pin(advance(pin(join(m[3], m[4], m[6], m[7]))));
+        const NodeId q3 = pin(advance(pin(join(m[4], m[5], m[7], m[8]))));
+        result = join(q0, q1, q2, q3);
+        pins_.resize(base);
+    }
+    nodes_[id].result = result;
+    return result;
+}
+
+// Double the universe around its center, the old root becoming its middle.
+void HashLife::expand()
+{
+    const Node r = nodes_[root_];
+    if (r.level >= MAX_LEVEL) {
+        throw std::length_error("HashLife universe exceeds 64-bit coordinates");
+    }
+    const NodeId e = empty(r.level - 1);
+    const std::size_t base = pins_.size();
+    const NodeId q0 = pin(join(e, e, e, nw(r)));
+    const NodeId q1 = pin(join(e, e, ne(r), e));
+    const NodeId q2 = pin(join(e, sw(r), e, e));
+    const NodeId q3 = join(se(r), e, e, e);
+    root_ = join(q0, q1, q2, q3);
+    pins_.resize(base);
+}
+
+// True if all live cells of a level >= 5 node lie in its central half, the
+// window its result covers.
+bool HashLife::confined(NodeId id) const
+{
+    const Node& n = nodes_[id];
+    const Node& a = nodes_[nw(n)];
+    const Node& b = nodes_[ne(n)];
+    const Node& c = nodes_[sw(n)];
+    const Node& d = nodes_[se(n)];
+    return isEmpty(nw(a)) && isEmpty(ne(a)) && isEmpty(sw(a))
+        && isEmpty(nw(b)) && isEmpty(ne(b)) && isEmpty(se(b))
+        && isEmpty(nw(c)) && isEmpty(sw(c)) && isEmpty(se(c))
+        && isEmpty(ne(d)) && isEmpty(sw(d)) && isEmpty(se(d));
+}
+
+void HashLife::step(uint64_t generations)
+{
+    pins_.clear();
+    for (int j = 63; j >= 0; --j) {
+        if (((generations >> j) & 1) == 0) {
+            continue;
+        }
+        setStepLog(j);
+        // Big enough for a 2^j step, with the pattern in the root's central
+        // half; one more doubling puts it in the central quarter, at least
+        // 2^j cells inside the central half the result keeps, so nothing can
+        // leave that in the time.
+        while (nodes_[root_].level < std::max(LEAF_LEVEL + 2, j + 3) || !confined(root_)) {
+            expand();
+        }
+        expand();
+        root_ = advance(root_);
+        generation_ += uint64_t { 1 } << j;
+    }
+}
+
+void HashLife::clear()
+{
+    pins_.clear();
+    root_ = empty(LEAF_LEVEL + 2);
+    generation_ = 0;
+}
+
+HashLife::NodeId HashLife::build(const DynamicGrid& grid, int level, int64_t x0, int64_t y0)
+{
+    if (x0 >= grid.height() || y0 >= grid.width()) {
+        return empty(level);
+    }
+    if (level == LEAF_LEVEL) {
+        uint64_t cells = 0;
+        for (int r = 0; r < 8 && x0 + r < grid.height(); ++r) {
+            for (int col = 0; col < 8 && y0 + col < grid.width(); ++col) {
+                if (grid.get({ static_cast<int>(x0 + r), static_cast<int>(y0 + col) })) {
+                    cells |= 1ULL << (8 * r + col);
+                }
+            }
+        }
+        return leaf(cells);
+    }
+    const int64_t s = int64_t { 1 } << (level - 1);
+    const std::size_t base = pins_.size();
+    const NodeId q0 = pin(build(grid, level - 1, x0, y0));
+    const NodeId q1 = pin(build(grid, level - 1, x0, y0 + s));
+    const NodeId q2 = pin(build(grid, level - 1, x0 + s, y0));
+    const NodeId q3 = build(grid, level - 1, x0 + s, y0 + s);
+    const NodeId id = join(q0, q1, q2, q3);
+    pins_.resize(base);
+    return id;
+}
+
+// The grid goes into the root's south-east quadrant, which starts at (0, 0).
+void HashLife::fromGrid(const DynamicGrid& grid)
+{
+    clear();
+    int level = LEAF_LEVEL + 2;
+    while ((int64_t { 1 } << (level - 1)) < std::max(grid.width(), grid.height())) {
+        ++level;
+    }
+    const NodeId e = empty(level - 1);
+    root_ = join(e, e, e, build(grid, level - 1, 0, 0));
+}
+
+void HashLife::toGrid(DynamicGrid& grid, int64_t x0, int64_t y0) const
+{
+    grid.clear();
+    // Paint node id, whose top-left cell is (ox, oy) in grid coordinates.
+    const auto paint = [&](const auto& self, NodeId id, int64_t ox, int64_t oy) -> void {
+        const Node& n = nodes_[id];
+        const int64_t size = int64_t { 1 } << n.level;
+        if (isEmpty(id) || ox >= grid.height() || oy >= grid.width() || ox + size <= 0 || oy + size <= 0) {
+            return;
+        }
+        if (n.level == LEAF_LEVEL) {
+            for (uint64_t cells = n.a; cells != 0; cells &= cells - 1) {
+                const int bit = std::countr_zero(cells);
+                const int64_t x = ox + (bit >> 3);
+                const int64_t y = oy + (bit & 7);
+                if (x >= 0 && x < grid.height() && y >= 0 && y < grid.width()) {
+                    grid.set({ static_cast<int>(x), static_cast<int>(y) }, true);
+                }
+            }
+            return;
+        }
+        const int64_t s = size / 2;
+        self(self, nw(n), ox, oy);
+        self(self, ne(n), ox, oy + s);
+        self(self, sw(n), ox + s, oy);
+        self(self, se(n), ox + s, oy + s);
+    };
+    const int64_t h = half();
+    paint(paint, root_, -h - x0, -h - y0);
+}
+
+bool HashLife::get(int64_t x, int64_t y) const
+{
+    const int64_t h = half();
+    if (x < -h || x >= h || y < -h || y >= h) {
+        return false;
+    }
+    x += h;
+    y += h;
+    NodeId id = root_;
+    while (nodes_[id].level > LEAF_LEVEL) {
+        const Node& n = nodes_[id];
+        const int64_t s = int64_t { 1 } << (n.level - 1);
+        const bool south = x >= s;
+        const bool east = y >= s;
+        id = south ? (east ? se(n) : sw(n)) : (east ? ne(n) : nw(n));
+        x -= south ? s : 0;
+        y -= east ? s : 0;
+    }
+    return (nodes_[id].a >> (8 * x + y)) & 1;
+}
+
+// Path copy: a new node for every level from the root down to the cell.
+HashLife::NodeId HashLife::setCell(NodeId id, int64_t x, int64_t y, bool alive)
+{
+    const Node n = nodes_[id];
+    if (n.level == LEAF_LEVEL) {
+        const uint64_t bit = 1ULL << (8 * x + y);
+        return leaf(alive ? (n.a | bit) : (n.a & ~bit));
+    }
+    const int64_t s = int64_t { 1 } << (n.level - 1);
+    NodeId kids[4] = { nw(n), ne(n), sw(n), se(n) };
+    const int q = (x >= s ? 2 : 0) + (y >= s ? 1 : 0);
+    kids[q] = setCell(kids[q], x >= s ? x - s : x, y >= s ? y - s : y, alive);
+    return join(kids[0], kids[1], kids[2], kids[3]);
+}
+
+void HashLife::set(int64_t x, int64_t y, bool alive)
+{
+    pins_.clear();
+    while (x < -half() || x >= half() || y < -half() || y >= half()) {
+        expand();
+    }
+    const int64_t h = half();
+    root_ = setCell(root_, x + h, y + h, alive);
+}
+
+uint64_t HashLife::population() const
+{
+    std::unordered_map<NodeId, uint64_t> counts;
+    const auto count = [&](const auto& self, NodeId id) -> uint64_t {
+        const Node& n = nodes_[id];
+        if (n.level == LEAF_LEVEL) {
+            return static_cast<uint64_t>(std::popcount(n.a));
+        }
+        if (isEmpty(id)) {
+            return 0;
+        }
+        if (const auto it = counts.find(id); it != counts.end()) {
+            return it->second;
+        }
+        const uint64_t total = self(self, nw(n)) + self(self, ne(n)) + self(self, sw(n)) + self(self, se(n));
+        counts.emplace(id, total);
+        return total;
+    };
+    return count(count, root_);
+}
@@ -0,0 +1,118 @@
+// Conway's Game of Life
+// Copyright (c) 2025 Faraz Fallahi <fffaraz@gmail.com>
+
+#pragma once
+
+#include "Rule.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class DynamicGrid;
+
+// Gosper's HashLife on an unbounded plane. The universe is a quadtree whose
+// nodes are hash-consed (every distinct 2^k x 2^k block exists once), and each
+// node memoizes its center 2^(k-1) x 2^(k-1) block advanced 2^(k-2) generations,
+// so repetition in space and time is computed once. Patterns with that kind of
+// structure (oscillators, spaceships, guns, breeders) can be jumped to
+// generation 2^40 and beyond in milliseconds; chaotic soups gain little.
+//
+// Cells are addressed like DynamicGrid: x is the row, y the column, and a grid
+// imported with fromGrid() occupies rows [0, height) and columns [0, width).
+// Unlike a grid there are no edges, so results match a Dead-boundary grid only
+// while the pattern stays clear of that grid's edges.
+//
+// Nodes live in one pool capped by a memory budget. When the pool is full a
+// mark-and-sweep collection frees every node not reachable from the universe or
+// from a step in progress; if that is not enough it also drops the memoized
+// results and collects again. Nodes are never moved, so ids held by the running
+// recursion stay valid.
+class HashLife {
+public:
+    static constexpr std::size_t DEFAULT_MEMORY_BUDGET = std::size_t { 512 } << 20;
+
+    // Throws std::invalid_argument for a B0 rule: it flips the infinite empty
+    // background every generation, which a quadtree of finite nodes cannot hold.
+    explicit HashLife(const Rule& rule = Rule {}, std::size_t memoryBudget = DEFAULT_MEMORY_BUDGET);
+
+    const Rule& rule() const { return rule_; }
+    uint64_t generation() const { return generation_; }
+
+    // Replace the universe with grid's live cells; generation restarts at 0.
+    void fromGrid(const DynamicGrid& grid);
+    // Copy rows [x0, x0 + height) and columns [y0, y0 + width) of the universe
+    // into grid; everything outside that window is left out.
+    void toGrid(DynamicGrid& grid, int64_t x0 = 0, int64_t y0 = 0) const;
+
+    bool get(int64_t x, int64_t y) const;
+    void set(int64_t x, int64_t y, bool alive);
+    void clear();
+
+    // Advance the universe by `generations`, one power-of-two jump per set bit.
+    // Throws std::length_error if the pattern alone outgrows the memory budget.
+    void step(uint64_t generations);
+
+    uint64_t population() const;
+    std::size_t nodeCount() const { return nodes_.size() - freeCount_; }
+    std::size_t memoryUsage() const;
+    std::size_t memoryBudget() const { return memoryBudget_; }
+    int collections() const { return collections_; }
+
+private:
+    using NodeId = uint32_t;
+    static constexpr NodeId NONE = ~NodeId { 0 };
+    static constexpr int LEAF_LEVEL = 3; // 8x8 leaves
+
+    // Level 3: a = the 8x8 cells, row r in bits 8r..8r+7 (bit 8r+c is column c).
+    // Above: the four children, nw | ne << 32 in a and sw | se << 32 in b.
+    struct Node {
+        uint64_t a;
+        uint64_t b;
+        NodeId result; // memoized center after 2^min(stepLog_, level-2) gens
+        NodeId next; // hash chain, or free list link
+        uint8_t level;
+        bool marked;
+    };
+
+    Rule rule_;
+    std::size_t memoryBudget_;
+    std::size_t maxNodes_;
+    std::vector<Node> nodes_;
+    std::vector<NodeId> buckets_;
+    NodeId freeList_ = NONE;
+    std::size_t freeCount_ = 0;
+    std::vector<NodeId> empty_; // canonical empty node per level
+    std::vector<NodeId> pins_; // intermediate nodes of the step in progress
+    NodeId root_ = NONE;
+    int stepLog_ = 0; // memoized results advance 2^min(stepLog_, level-2)
+    uint64_t generation_ = 0;
+    int collections_ = 0;
+
+    static NodeId nw(const Node& n) { return static_cast<NodeId>(n.a); }
+    static NodeId ne(const Node& n) { return static_cast<NodeId>(n.a >> 32); }
+    static NodeId sw(const Node& n) { return static_cast<NodeId>(n.b); }
+    static NodeId se(const Node& n) { return static_cast<NodeId>(n.b >> 32); }
+
+    NodeId intern(int level, uint64_t a, uint64_t b);
+    NodeId leaf(uint64_t cells) { return intern(LEAF_LEVEL, cells, 0); }
+    NodeId join(NodeId nw, NodeId ne, NodeId sw, NodeId se);
+    NodeId empty(int level);
+    NodeId pin(NodeId id);
+    NodeId allocate();
+    void growBuckets();
+    void collect(bool dropResults);
+    void mark(NodeId id, bool followResults);
+    void setStepLog(int stepLog);
+
+    NodeId center(NodeId id);
+    NodeId advance(NodeId id);
+    NodeId advanceLeaves(NodeId id);
+    void expand();
+    bool confined(NodeId id) const;
+
+    NodeId build(const DynamicGrid& grid, int level, int64_t x0, int64_t y0);
+    NodeId setCell(NodeId id, int64_t x, int64_t y, bool alive);
+    bool isEmpty(NodeId id) const;
+    int64_t half() const { return int64_t { 1 } << (nodes_[root_].level - 1); }
+};
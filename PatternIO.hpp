@@ -0,0 +1,50 @@
+// Conway's Game of Life
+// Copyright (c) 2025 Faraz Fallahi <fffaraz@gmail.com>
+
+#pragma once
+
+#include "Rule.hpp"
+
+#include <cstdint>
+#include <iosfwd>
+#include <optional>
+#include <string>
+
+class DynamicGrid;
+
+// Pattern files: RLE (.rle), plaintext (.cells) and Golly's Macrocell (.mc).
+// Readers stream the file through a fixed-size buffer and OR live cells straight
+// into the grid's packed words (whole runs at a time for RLE, 8-cell leaf rows
+// for Macrocell), so even huge files load in bounded memory and without a set()
+// per cell; Macrocell alone keeps its node table, as it is the pattern. Writers
+// likewise scan words for runs rather than cells.
+//
+// A pattern's origin (its top-left cell, or a Macrocell root's top-left corner)
+// goes to the given grid cell, and whatever falls outside the grid is dropped.
+// Writers put the grid's cell (0, 0) at the origin, so a saved grid loads back
+// in place.
+enum class PatternFormat {
+    Rle,
+    Cells,
+    Macrocell,
+};
+
+// The format for a file name's extension (.rle, .cells or .mc, any case).
+bool patternFormatForPath(const std::string& path, PatternFormat& format);
+
+struct PatternInfo {
+    int64_t width = 0; // the pattern's extent: the RLE header's, the longest
+    int64_t height = 0; // .cells line and line count, or the Macrocell root's
+    std::optional<Rule> rule; // the rule the file names, if any
+};
+
+// Add the pattern's live cells to grid (which keeps its other cells; clear it
+// first for just the pattern), its origin at row x0, column y0. Throws
+// std::runtime_error for unreadable files and malformed or unsupported content.
+PatternInfo loadPattern(const std::string& path, DynamicGrid& grid, int64_t x0 = 0, int64_t y0 = 0);
+PatternInfo loadPattern(std::istream& in, PatternFormat format, DynamicGrid& grid, int64_t x0 = 0, int64_t y0 = 0);
+
+// Write grid's live cells and rule. Throws std::runtime_error if the file cannot
+// be written.
+void savePattern(const std::string& path, const DynamicGrid& grid);
+void savePattern(std::ostream& out, PatternFormat format, const DynamicGrid& grid);
@@ -0,0 +1,53 @@
+// Conway's Game of Life
+// Copyright (c) 2025 Faraz Fallahi <fffaraz@gmail.com>
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+
+// Counter-based random numbers: number n of stream `seed` is a pure function of
+// the two, SplitMix64's output mix of the stream's n-th Weyl step. Any thread
+// can produce any part of a stream without sharing or advancing a generator,
+// so a fill split among threads comes out the same however it is split.
+inline uint64_t counterRandom(const uint64_t seed, const uint64_t counter)
+{
+    const auto mix = [](uint64_t z) {
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    };
+    // The seed is mixed first so that nearby seeds start far apart.
+    return mix(mix(seed) + ((counter + 1) * 0x9e3779b97f4a7c15ULL));
+}
+
+// A density in [0, 1] as the chance out of 65536 that randomWord sets a bit.
+inline uint32_t densityThreshold(const double density)
+{
+    return static_cast<uint32_t>((std::clamp(density, 0.0, 1.0) * 65536) + 0.5);
+}
+
+// Word `index` of a random fill: each bit set with probability
+// threshold / 65536, independently. The 64 bits are bit-sliced: each compares
+// its own 16-bit uniform number against the threshold, most significant bit
+// first, one random word per bit down to the threshold's lowest set one, so a
+// density of 1/2 costs one number per word, 1/4 or 3/4 two, and none more than
+// 16. Uses counters 16 * index to 16 * index + 15 of the stream.
+inline uint64_t randomWord(const uint64_t seed, const uint64_t index, const uint32_t threshold)
+{
+    if (threshold >= 65536) {
+        return ~0ULL;
+    }
+    uint64_t less = 0;
+    uint64_t equal = ~0ULL;
+    for (int bit = 15; bit >= 0 && equal != 0 && (threshold & ((2u << bit) - 1)) != 0; --bit) {
+        const uint64_t r = counterRandom(seed, (index * 16) + static_cast<uint64_t>(15 - bit));
+        if ((threshold >> bit) & 1) {
+            less |= equal & ~r;
+            equal &= r;
+        } else {
+            equal &= ~r;
+        }
+    }
+    return less;
+}
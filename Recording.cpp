@@ -0,0 +1,341 @@
+// Conway's Game of Life
+// Copyright (c) 2025 Faraz Fallahi <fffaraz@gmail.com>
+
+#include "Recording.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+
+namespace {
+
+constexpr std::array<char, 8> MAGIC { 'G', 'O', 'L', 'R', 'E', 'C', 'R', '\n' };
+constexpr std::array<char, 8> INDEX_MAGIC { 'G', 'O', 'L', 'R', 'I', 'D', 'X', '\n' };
+constexpr uint32_t VERSION = 1;
+constexpr uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+struct FileHeader {
+    std::array<char, 8> magic;
+    uint32_t version;
+    uint32_t byteOrder;
+    int32_t width;
+    int32_t height;
+    int32_t wordsPerRow;
+    uint32_t boundary;
+    uint16_t birth;
+    uint16_t survive;
+    uint32_t keyframeInterval;
+};
+
+struct FrameHeader {
+    uint64_t generation;
+    uint32_t keyframe;
+    uint32_t reserved;
+    uint64_t tokenWords; // the frame's token and literal words that follow
+};
+
+// After the index (a generation, file offset pair per keyframe), at the very end.
+struct Footer {
+    uint64_t indexOffset;
+    uint64_t keyframes;
+    uint64_t lastGeneration;
+    std::array<char, 8> magic;
+};
+
+// The most words encode() can produce for `words` words: literal runs break
+// only at two zero words, so at worst every three words take a token and two
+// literals.
+std::size_t maxTokens(const std::size_t words)
+{
+    return words + (words / 3) + 1;
+}
+
+// Run-length code `words` words (row-major from `cur`), XORed with `prev` unless
+// keyframe, into out (maxTokens(words) long), and make prev a copy of cur.
+// Returns the end of the tokens; trailingZeros gets the zero words after the
+// last literal.
+uint64_t* encode(const uint64_t* cur, uint64_t* prev, const std::size_t words, const bool keyframe, uint64_t* out, uint64_t& trailingZeros)
+{
+    const uint64_t mask = keyframe ? 0 : ~0ULL;
+    uint64_t zeros = 0;
+    std::size_t i = 0;
+    while (i < words) {
+        const uint64_t first = cur[i] ^ (prev[i] & mask);
+        prev[i] = cur[i];
+        ++i;
+        if (first == 0) {
+            ++zeros;
+            continue;
+        }
+        uint64_t* const token = out++;
+        *out++ = first;
+        // Literals run until two zero words in a row, which are cheaper as a skip.
+        while (i < words) {
+            const uint64_t d = cur[i] ^ (prev[i] & mask);
+            if (d == 0 && (i + 1 == words || (cur[i + 1] ^ (prev[i + 1] & mask)) == 0)) {
+                break;
+            }
+            prev[i] = cur[i];
+            *out++ = d;
+            ++i;
+        }
+        *token = (zeros << 32) | static_cast<uint64_t>(out - token - 1);
+        zeros = 0;
+    }
+    trailingZeros = zeros;
+    return out;
+}
+
+[[noreturn]] void corrupt(const std::string& path)
+{
+    throw std::runtime_error(path + ": corrupt recording");
+}
+
+} // namespace
+
+Recorder::Recorder(const std::string& path, const DynamicGrid& grid, const uint64_t generation, const int keyframeInterval)
+    : path_(path)
+    , out_(path, std::ios::binary | std::ios::trunc)
+    , width_(grid.width())
+    , height_(grid.height())
+    , wordsPerRow_(grid.wordsPerRow())
+    , keyframeInterval_(std::max(1, keyframeInterval))
+    , firstGeneration_(generation)
+    , generation_(generation)
+    , previous_(static_cast<std::size_t>(height_) * wordsPerRow_, 0)
+    , chunks_(height_)
+{
+    if (!out_) {
+        throw std::runtime_error(path + ": cannot create");
+    }
+    FileHeader h {};
+    h.magic = MAGIC;
+    h.version = VERSION;
+    h.byteOrder = BYTE_ORDER_MARK;
+    h.width = width_;
+    h.height = height_;
+    h.wordsPerRow = wordsPerRow_;
+    h.boundary = static_cast<uint32_t>(grid.boundary());
+    h.birth = grid.rule().birth;
+    h.survive = grid.rule().survive;
+    h.keyframeInterval = static_cast<uint32_t>(keyframeInterval_);
+    write(&h, sizeof(h));
+    writeFrame(grid, true);
+}
+
+Recorder::~Recorder()
+{
+    try {
+        finish();
+    } catch (const std::runtime_error&) {
+        // The frames are on disk; a replayer rebuilds the missing index.
+    }
+}
+
+void Recorder::record(const DynamicGrid& grid)
+{
+    if (grid.width() != width_ || grid.height() != height_) {
+        throw std::runtime_error(path_ + ": recorded grid changed size");
+    }
+    ++generation_;
+    writeFrame(grid, (generation_ - firstGeneration_) % static_cast<uint64_t>(keyframeInterval_) == 0);
+}
+
+void Recorder::finish()
+{
+    if (finished_) {
+        return;
+    }
+    finished_ = true;
+    const Footer footer { offset_, keyframes_.size(), generation_, INDEX_MAGIC };
+    write(keyframes_.data(), keyframes_.size() * sizeof(keyframes_[0]));
+    write(&footer, sizeof(footer));
+    out_.close();
+    if (!out_) {
+        throw std::runtime_error(path_ + ": error writing recording");
+    }
+}
+
+void Recorder::writeFrame(const DynamicGrid& grid, const bool keyframe)
+{
+    // Each band codes its own rows into the chunk of its first row. The chunks'
+    // token streams then go out one after another, the zeros ending one chunk
+    // carried into the skip that starts the next.
+    const std::size_t wpr = static_cast<std::size_t>(wordsPerRow_);
+    grid.forEachBand([&](int begin, int end) {
+        Chunk& chunk = chunks_[begin];
+        const std::size_t first = static_cast<std::size_t>(begin) * wpr;
+        const std::size_t words = static_cast<std::size_t>(end - begin) * wpr;
+        chunk.end = end;
+        chunk.tokens.resize(std::max(chunk.tokens.size(), maxTokens(words)));
+        const uint64_t* const tokensEnd = encode(grid.row(begin), previous_.data() + first, words, keyframe, chunk.tokens.data(), chunk.trailingZeros);
+        chunk.size = static_cast<std::size_t>(tokensEnd - chunk.tokens.data());
+    });
+
+    uint64_t carry = 0;
+    uint64_t tokenWords = 0;
+    for (int x = 0; x < height_; x = chunks_[x].end) {
+        Chunk& chunk = chunks_[x];
+        if (chunk.size == 0) {
+            carry += chunk.trailingZeros;
+            continue;
+        }
+        chunk.tokens[0] += carry << 32;
+        carry = chunk.trailingZeros;
+        tokenWords += chunk.size;
+    }
+    if (keyframe) {
+        keyframes_.emplace_back(generation_, offset_);
+    }
+    const FrameHeader h { generation_, keyframe ? 1U : 0U, 0, tokenWords };
+    write(&h, sizeof(h));
+    for (int x = 0; x < height_; x = chunks_[x].end) {
+        write(chunks_[x].tokens.data(), chunks_[x].size * sizeof(uint64_t));
+    }
+}
+
+void Recorder::write(const void* data, const std::size_t bytes)
+{
+    out_.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+    if (!out_) {
+        throw std::runtime_error(path_ + ": error writing recording");
+    }
+    offset_ += bytes;
+}
+
+Replayer::Replayer(const std::string& path)
+    : path_(path)
+    , in_(path, std::ios::binary)
+{
+    if (!in_) {
+        throw std::runtime_error(path + ": cannot open");
+    }
+    FileHeader h {};
+    if (!in_.read(reinterpret_cast<char*>(&h), sizeof(h)) || h.magic != MAGIC) {
+        throw std::runtime_error(path + ": not a recording");
+    }
+    if (h.byteOrder != BYTE_ORDER_MARK) {
+        throw std::runtime_error(path + ": recording from a host of the other byte order");
+    }
+    if (h.version != VERSION) {
+        throw std::runtime_error(path + ": unsupported recording version " + std::to_string(h.version));
+    }
+    if (h.width <= 0 || h.height <= 0 || h.wordsPerRow != (h.width + 63) / 64 || h.boundary > static_cast<uint32_t>(Boundary::Alive)) {
+        corrupt(path);
+    }
+    width_ = h.width;
+    height_ = h.height;
+    wordsPerRow_ = h.wordsPerRow;
+    boundary_ = static_cast<Boundary>(h.boundary);
+    rule_ = Rule { h.birth, h.survive };
+    words_.resize(static_cast<std::size_t>(height_) * wordsPerRow_);
+
+    in_.seekg(0, std::ios::end);
+    const uint64_t size = static_cast<uint64_t>(in_.tellg());
+    Footer footer {};
+    if (size >= sizeof(h) + sizeof(footer)) {
+        in_.seekg(static_cast<std::streamoff>(size - sizeof(footer)));
+        in_.read(reinterpret_cast<char*>(&footer), sizeof(footer));
+    }
+    if (in_ && footer.magic == INDEX_MAGIC && footer.indexOffset + (footer.keyframes * sizeof(keyframes_[0])) + sizeof(footer) == size) {
+        keyframes_.resize(footer.keyframes);
+        in_.seekg(static_cast<std::streamoff>(footer.indexOffset));
+        in_.read(reinterpret_cast<char*>(keyframes_.data()), static_cast<std::streamsize>(keyframes_.size() * sizeof(keyframes_[0])));
+        lastGeneration_ = footer.lastGeneration;
+    } else {
+        // No index (the recorder did not finish): walk the frame headers, up to
+        // the first incomplete frame or the first that does not follow the one
+        // before (the start of a partly written index).
+        in_.clear();
+        uint64_t offset = sizeof(h);
+        FrameHeader frame {};
+        while (offset + sizeof(frame) <= size) {
+            in_.seekg(static_cast<std::streamoff>(offset));
+            in_.read(reinterpret_cast<char*>(&frame), sizeof(frame));
+            const uint64_t end = offset + sizeof(frame) + (frame.tokenWords * sizeof(uint64_t));
+            const bool follows = keyframes_.empty() ? frame.keyframe != 0 : frame.generation == lastGeneration_ + 1;
+            if (!in_ || end > size || !follows) {
+                break;
+            }
+            if (frame.keyframe != 0) {
+                keyframes_.emplace_back(frame.generation, offset);
+            }
+            lastGeneration_ = frame.generation;
+            offset = end;
+        }
+        in_.clear();
+    }
+    if (!in_ || keyframes_.empty()) {
+        throw std::runtime_error(path + ": recording holds no complete frame");
+    }
+}
+
+void Replayer::seek(const uint64_t generation, DynamicGrid& grid)
+{
+    if (generation < firstGeneration() || generation > lastGeneration_) {
+        throw std::out_of_range(path_ + ": generation " + std::to_string(generation) + " is not recorded");
+    }
+    if (grid.width() != width_ || grid.height() != height_) {
+        throw std::runtime_error(path_ + ": recording is " + std::to_string(width_) + "x" + std::to_string(height_) + ", grid is "
+            + std::to_string(grid.width()) + "x" + std::to_string(grid.height()));
+    }
+    // The last keyframe at or before generation; decode from it unless the
+    // current generation is already past it (and not past the target).
+    const auto key = std::prev(std::upper_bound(keyframes_.begin(), keyframes_.end(), std::make_pair(generation, UINT64_MAX)));
+    if (!decoded_ || generation_ > generation || generation_ < key->first) {
+        next_ = key->second;
+        readFrame();
+    }
+    while (generation_ < generation) {
+        readFrame();
+    }
+
+    const std::size_t wpr = static_cast<std::size_t>(wordsPerRow_);
+    grid.forEachBand([&](int begin, int end) {
+        std::memcpy(grid.rowForEdit(begin), words_.data() + (static_cast<std::size_t>(begin) * wpr), static_cast<std::size_t>(end - begin) * wpr * sizeof(uint64_t));
+    });
+    grid.setBoundary(boundary_);
+    grid.setRule(rule_);
+    grid.endEdits();
+}
+
+// Decode the frame at next_ into words_.
+void Replayer::readFrame()
+{
+    FrameHeader h {};
+    in_.seekg(static_cast<std::streamoff>(next_));
+    in_.read(reinterpret_cast<char*>(&h), sizeof(h));
+    if (!in_ || (decoded_ && h.keyframe == 0 && h.generation != generation_ + 1)) {
+        corrupt(path_);
+    }
+    tokens_.resize(h.tokenWords);
+    in_.read(reinterpret_cast<char*>(tokens_.data()), static_cast<std::streamsize>(tokens_.size() * sizeof(uint64_t)));
+    if (!in_) {
+        corrupt(path_);
+    }
+    decoded_ = false;
+    if (h.keyframe != 0) {
+        std::fill(words_.begin(), words_.end(), 0ULL);
+    }
+    // Literals XOR into the previous generation (or, for a keyframe, into zeros).
+    std::size_t pos = 0;
+    std::size_t t = 0;
+    while (t < tokens_.size()) {
+        const uint64_t token = tokens_[t++];
+        const std::size_t count = token & 0xffffffffULL;
+        pos += token >> 32;
+        if (pos + count > words_.size() || t + count > tokens_.size()) {
+            corrupt(path_);
+        }
+        for (std::size_t i = 0; i < count; ++i) {
+            words_[pos + i] ^= tokens_[t + i];
+        }
+        pos += count;
+        t += count;
+    }
+    generation_ = h.generation;
+    next_ += sizeof(h) + (tokens_.size() * sizeof(uint64_t));
+    decoded_ = true;
+}
@@ -0,0 +1,118 @@
+// Conway's Game of Life
+// Copyright (c) 2025 Faraz Fallahi <fffaraz@gmail.com>
+
+#pragma once
+
+#include "AlignedAllocator.hpp"
+#include "Grid.hpp"
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Recordings of every generation of a run. Each generation is stored as the XOR
+// of its words with the previous generation's, run-length coded by words: a
+// token word (zero words to skip << 32 | literal count) and then the literal
+// words. Once a pattern settles most words XOR to zero, so a generation costs a
+// few bytes per changed word. Every keyframeInterval generations a keyframe
+// stores the words themselves (coded the same way, against an empty grid), and
+// an index of the keyframes at the end of the file lets the Replayer seek to any
+// generation by decoding at most keyframeInterval - 1 deltas past a keyframe.
+// A recording cut short (a crash) still replays: the index is rebuilt by walking
+// the frames, and a torn last frame is dropped.
+//
+// The recorder encodes on the grid's update bands, each band XORing and coding
+// its own rows (still in that worker's cache from the step), and the bands'
+// tokens are written straight from their buffers, so a generation costs one
+// pass over the words plus the write.
+// Like checkpoints, words are stored in host byte order.
+class Recorder {
+public:
+    static constexpr int DEFAULT_KEYFRAME_INTERVAL = 256;
+
+    // Create path and record grid as generation `generation`, a keyframe.
+    // Throws std::runtime_error if the file cannot be written.
+    Recorder(const std::string& path, const DynamicGrid& grid, uint64_t generation = 0, int keyframeInterval = DEFAULT_KEYFRAME_INTERVAL);
+    ~Recorder();
+    Recorder(const Recorder&) = delete;
+    Recorder& operator=(const Recorder&) = delete;
+
+    // Record grid as the generation after the last one recorded. It must have
+    // the first grid's dimensions; its boundary and rule are not recorded again.
+    void record(const DynamicGrid& grid);
+    // Write the keyframe index and close the file (the destructor does this too).
+    void finish();
+
+    uint64_t lastGeneration() const { return generation_; }
+    // File size so far.
+    uint64_t bytes() const { return offset_; }
+
+private:
+    struct Chunk {
+        int end = 0; // the band's rows are [its first row, end)
+        uint64_t trailingZeros = 0; // words after its last literal
+        std::vector<uint64_t> tokens; // room for the most the rows can take
+        std::size_t size = 0; // tokens used
+    };
+
+    void writeFrame(const DynamicGrid& grid, bool keyframe);
+    void write(const void* data, std::size_t bytes);
+
+    std::string path_;
+    std::ofstream out_;
+    int width_;
+    int height_;
+    int wordsPerRow_;
+    int keyframeInterval_;
+    uint64_t firstGeneration_;
+    uint64_t generation_;
+    uint64_t offset_ = 0;
+    std::vector<uint64_t, AlignedAllocator<uint64_t>> previous_; // the last recorded generation's words
+    std::vector<Chunk> chunks_; // by a band's first row
+    std::vector<std::pair<uint64_t, uint64_t>> keyframes_; // generation, file offset
+    bool finished_ = false;
+};
+
+class Replayer {
+public:
+    // Open a recording. Throws std::runtime_error if it is unreadable, not a
+    // recording or holds no complete frame.
+    explicit Replayer(const std::string& path);
+
+    int width() const { return width_; }
+    int height() const { return height_; }
+    Boundary boundary() const { return boundary_; }
+    const Rule& rule() const { return rule_; }
+    uint64_t firstGeneration() const { return keyframes_.front().first; }
+    uint64_t lastGeneration() const { return lastGeneration_; }
+    std::size_t keyframes() const { return keyframes_.size(); }
+
+    // Make grid (which must have the recording's dimensions) generation
+    // `generation`, with the recording's boundary and rule. Moving forward
+    // decodes only the deltas in between unless a keyframe is closer. Throws
+    // std::out_of_range outside [firstGeneration, lastGeneration] and
+    // std::runtime_error for a corrupt file.
+    void seek(uint64_t generation, DynamicGrid& grid);
+    // The generation seek last produced.
+    uint64_t generation() const { return generation_; }
+
+private:
+    void readFrame();
+
+    std::string path_;
+    std::ifstream in_;
+    int width_ = 0;
+    int height_ = 0;
+    int wordsPerRow_ = 0;
+    Boundary boundary_ = Boundary::Dead;
+    Rule rule_;
+    uint64_t lastGeneration_ = 0;
+    std::vector<std::pair<uint64_t, uint64_t>> keyframes_; // generation, file offset
+    std::vector<uint64_t, AlignedAllocator<uint64_t>> words_; // generation_'s words
+    std::vector<uint64_t> tokens_;
+    uint64_t generation_ = 0;
+    uint64_t next_ = 0; // file offset of the frame after generation_'s
+    bool decoded_ = false; // words_ holds generation_
+};
@@ -0,0 +1,64 @@
+// Conway's Game of Life
+// Copyright (c) 2025 Faraz Fallahi <fffaraz@gmail.com>
+
+#include "Render.hpp"
+
+#include <algorithm>
+#include <vector>
+
+void renderGrid(const DynamicGrid& grid, const Palette& palette, uint32_t* const pixels, const std::size_t pitch)
+{
+    // Pixel by (alive << 4) | neighbor count, so a cell needs no branch.
+    std::array<uint32_t, 32> lut {};
+    std::fill(lut.begin(), lut.begin() + 16, palette.dead);
+    std::copy(palette.live.begin(), palette.live.end(), lut.begin() + 16);
+    // A single live color needs no neighbor counts: count 0 stands for all.
+    const bool counts = std::any_of(palette.live.begin(), palette.live.end(), [&](uint32_t c) { return c != palette.live[0]; });
+
+    const int width = grid.width();
+    const int wpr = grid.wordsPerRow();
+    grid.forEachRenderBand([&](int begin, int end) {
+        // Per worker, so frames after the first allocate nothing.
+        thread_local std::vector<uint64_t> planes;
+        if (counts) {
+            planes.resize(4 * static_cast<std::size_t>(wpr));
+        }
+        for (int x = begin; x < end; ++x) {
+            const uint64_t* const cells = grid.row(x);
+            uint32_t* const out = pixels + (static_cast<std::size_t>(x) * pitch);
+            bool planned = false;
+            for (int w = 0; w < wpr; ++w) {
+                const int cols = std::min(64, width - (w * 64));
+                uint32_t* const px = out + (w * 64);
+                uint64_t alive = cells[w];
+                if (alive == 0) {
+                    std::fill_n(px, cols, palette.dead);
+                    continue;
+                }
+                uint64_t p0 = 0;
+                uint64_t p1 = 0;
+                uint64_t p2 = 0;
+                uint64_t p3 = 0;
+                if (counts) {
+                    // Neighbor counts only for rows with something alive.
+                    if (!planned) {
+                        grid.neighborPlanes(x, planes.data());
+                        planned = true;
+                    }
+                    p0 = planes[w];
+                    p1 = planes[wpr + w];
+                    p2 = planes[(2 * wpr) + w];
+                    p3 = planes[(3 * wpr) + w];
+                }
+                for (int i = 0; i < cols; ++i) {
+                    px[i] = lut[((alive & 1) << 4) | (p0 & 1) | ((p1 & 1) << 1) | ((p2 & 1) << 2) | ((p3 & 1) << 3)];
+                    alive >>= 1;
+                    p0 >>= 1;
+                    p1 >>= 1;
+                    p2 >>= 1;
+                    p3 >>= 1;
+                }
+            }
+        }
+    });
+}
@@ -0,0 +1,35 @@
+// Conway's Game of Life
+// Copyright (c) 2025 Faraz Fallahi <fffaraz@gmail.com>
+
+#pragma once
+
+#include "Grid.hpp"
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+// Grid-to-pixels conversion shared by the GUI frontends. Pixels are 32 bits in
+// whatever format the frontend's texture wants; the palette is given in that
+// format, so the conversion itself is a table lookup per cell. With all nine
+// live colors the same, neighbor counts are not computed at all.
+struct Palette {
+    uint32_t dead;
+    std::array<uint32_t, 9> live; // by live-neighbor count
+};
+
+// The 32-bit pixel whose bytes in memory are r, g, b, a (RGBA byte order, as
+// SFML and raylib textures take it), whatever the host's endianness.
+constexpr uint32_t rgbaPixel(uint8_t r, uint8_t g, uint8_t b, uint8_t a)
+{
+    return std::bit_cast<uint32_t>(std::array<uint8_t, 4> { r, g, b, a });
+}
+
+// One pixel per cell: cell (x, y) goes to pixels[x * pitch + y], pitch being in
+// pixels. The rows are split into the same bands as grid's updates and each band
+// is painted on the core that updates it, so its rows are still in that core's
+// cache, but by a render pool of its own (see forEachRenderBand): a frame never
+// holds up the next update. Neighbor counts come from neighborPlanes, a row at
+// a time.
+void renderGrid(const DynamicGrid& grid, const Palette& palette, uint32_t* pixels, std::size_t pitch);
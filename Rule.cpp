@@ -0,0 +1,84 @@
+// Conway's Game of Life
+// Copyright (c) 2025 Faraz Fallahi <fffaraz@gmail.com>
+
+#include "Rule.hpp"
+
+#include <cctype> // std::tolower
+#include <cstring> // std::strcmp
+
+namespace {
+
+// Digits 0..8 starting at text, as a neighbor-count bit mask. Stops at the first
+// non-digit; returns false on 9 or a repeated digit.
+bool parseCounts(const char*& text, uint16_t& mask)
+{
+    mask = 0;
+    for (; *text >= '0' && *text <= '9'; ++text) {
+        const int n = *text - '0';
+        if (n > 8 || ((mask >> n) & 1)) {
+            return false;
+        }
+        mask |= static_cast<uint16_t>(1u << n);
+    }
+    return true;
+}
+
+} // namespace
+
+bool parseRule(const char* text, Rule& rule)
+{
+    for (const NamedRule& named : NAMED_RULES) {
+        if (std::strcmp(text, named.name) == 0) {
+            rule = named.rule;
+            return true;
+        }
+    }
+
+    Rule parsed;
+    if (std::tolower(static_cast<unsigned char>(*text)) != 'b') {
+        return false;
+    }
+    ++text;
+    if (!parseCounts(text, parsed.birth)) {
+        return false;
+    }
+    if (*text == '/') {
+        ++text;
+    }
+    if (std::tolower(static_cast<unsigned char>(*text)) != 's') {
+        return false;
+    }
+    ++text;
+    if (!parseCounts(text, parsed.survive) || *text != '\0') {
+        return false;
+    }
+    rule = parsed;
+    return true;
+}
+
+std::string ruleString(const Rule& rule)
+{
+    std::string text = "B";
+    for (int n = 0; n <= 8; ++n) {
+        if ((rule.birth >> n) & 1) {
+            text += static_cast<char>('0' + n);
+        }
+    }
+    text += "/S";
+    for (int n = 0; n <= 8; ++n) {
+        if ((rule.survive >> n) & 1) {
+            text += static_cast<char>('0' + n);
+        }
+    }
+    return text;
+}
+
+const char* ruleName(const Rule& rule)
+{
+    for (const NamedRule& named : NAMED_RULES) {
+        if (named.rule == rule) {
+            return named.name;
+        }
+    }
+    return nullptr;
+}
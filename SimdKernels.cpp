@@ -0,0 +1,224 @@
+// Conway's Game of Life
+// Copyright (c) 2025 Faraz Fallahi <fffaraz@gmail.com>
+
+#include "SimdKernels.hpp"
+#include "SwarKernel.hpp"
+
+#include <algorithm> // std::min
+#include <atomic>
+#include <cstdlib> // std::getenv
+#include <cstring> // std::strcmp
+
+#if GOL_X86_SIMD
+#if defined(_MSC_VER)
+#include <immintrin.h> // _xgetbv
+#include <intrin.h> // __cpuidex
+#else
+#include <cpuid.h> // __get_cpuid_count
+#endif
+
+// Defined in SimdKernelsAvx2.cpp / SimdKernelsAvx512.cpp.
+RowKernel rowKernelAvx2(int words, const Rule& rule);
+RowKernel rowKernelAvx512(int words, const Rule& rule);
+ColumnKernel columnKernelAvx2(const Rule& rule);
+ColumnKernel columnKernelAvx512(const Rule& rule);
+CountKernel countKernelAvx2();
+CountKernel countKernelAvx512();
+HashKernel hashKernelAvx2();
+HashKernel hashKernelAvx512();
+NeighborKernel neighborKernelAvx2();
+NeighborKernel neighborKernelAvx512();
+#endif
+
+namespace {
+
+#if GOL_X86_SIMD
+void cpuid(unsigned leaf, unsigned subleaf, unsigned regs[4])
+{
+#if defined(_MSC_VER)
+    int r[4];
+    __cpuidex(r, static_cast<int>(leaf), static_cast<int>(subleaf));
+    for (int i = 0; i < 4; ++i) {
+        regs[i] = static_cast<unsigned>(r[i]);
+    }
+#else
+    if (!__get_cpuid_count(leaf, subleaf, &regs[0], &regs[1], &regs[2], &regs[3])) {
+        regs[0] = regs[1] = regs[2] = regs[3] = 0;
+    }
+#endif
+}
+
+// XCR0: which register states the OS saves on context switch.
+uint64_t xgetbv0()
+{
+#if defined(_MSC_VER)
+    return _xgetbv(0);
+#else
+    unsigned eax = 0;
+    unsigned edx = 0;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (static_cast<uint64_t>(edx) << 32) | eax;
+#endif
+}
+#endif
+
+SimdLevel detect()
+{
+#if GOL_X86_SIMD
+    unsigned r[4];
+    cpuid(0, 0, r);
+    if (r[0] < 7) {
+        return SimdLevel::Scalar;
+    }
+    cpuid(1, 0, r);
+    const bool osxsave = (r[2] >> 27) & 1;
+    const bool avx = (r[2] >> 28) & 1;
+    if (!osxsave || !avx) {
+        return SimdLevel::Scalar;
+    }
+    const uint64_t xcr0 = xgetbv0();
+    if ((xcr0 & 0x6) != 0x6) { // XMM + YMM state
+        return SimdLevel::Scalar;
+    }
+    cpuid(7, 0, r);
+    const bool avx2 = (r[1] >> 5) & 1;
+    const bool avx512f = (r[1] >> 16) & 1;
+    if (avx512f && (xcr0 & 0xE0) == 0xE0) { // opmask + ZMM state
+        return SimdLevel::Avx512;
+    }
+    return avx2 ? SimdLevel::Avx2 : SimdLevel::Scalar;
+#else
+    return SimdLevel::Scalar;
+#endif
+}
+
+SimdLevel initialLevel()
+{
+    SimdLevel level = detectSimdLevel();
+    if (const char* env = std::getenv("GOL_SIMD")) {
+        if (std::strcmp(env, "scalar") == 0) {
+            level = SimdLevel::Scalar;
+        } else if (std::strcmp(env, "avx2") == 0) {
+            level = std::min(level, SimdLevel::Avx2);
+        }
+    }
+    return level;
+}
+
+std::atomic<SimdLevel>& levelSlot()
+{
+    static std::atomic<SimdLevel> level { initialLevel() };
+    return level;
+}
+
+} // namespace
+
+SimdLevel detectSimdLevel()
+{
+    static const SimdLevel level = detect();
+    return level;
+}
+
+SimdLevel activeSimdLevel()
+{
+    return levelSlot().load(std::memory_order_relaxed);
+}
+
+SimdLevel setSimdLevel(SimdLevel level)
+{
+    level = std::min(level, detectSimdLevel());
+    levelSlot().store(level, std::memory_order_relaxed);
+    return level;
+}
+
+const char* simdLevelName(SimdLevel level)
+{
+    switch (level) {
+    case SimdLevel::Avx512:
+        return "avx512";
+    case SimdLevel::Avx2:
+        return "avx2";
+    default:
+        return "scalar";
+    }
+}
+
+RowKernel rowKernel(SimdLevel level, int words, const Rule& rule)
+{
+#if GOL_X86_SIMD
+    switch (level) {
+    case SimdLevel::Avx512:
+        return rowKernelAvx512(words, rule);
+    case SimdLevel::Avx2:
+        return rowKernelAvx2(words, rule);
+    default:
+        break;
+    }
+#endif
+    (void)level;
+    return selectRowKernel<WordOps, WordOps>(words, rule);
+}
+
+ColumnKernel columnKernel(SimdLevel level, const Rule& rule)
+{
+#if GOL_X86_SIMD
+    switch (level) {
+    case SimdLevel::Avx512:
+        return columnKernelAvx512(rule);
+    case SimdLevel::Avx2:
+        return columnKernelAvx2(rule);
+    default:
+        break;
+    }
+#endif
+    (void)level;
+    return selectColumnKernel<WordOps, WordOps>(rule);
+}
+
+CountKernel countKernel(SimdLevel level)
+{
+#if GOL_X86_SIMD
+    switch (level) {
+    case SimdLevel::Avx512:
+        return countKernelAvx512();
+    case SimdLevel::Avx2:
+        return countKernelAvx2();
+    default:
+        break;
+    }
+#endif
+    (void)level;
+    return swarCount<WordOps, WordOps>;
+}
+
+HashKernel hashKernel(SimdLevel level)
+{
+#if GOL_X86_SIMD
+    switch (level) {
+    case SimdLevel::Avx512:
+        return hashKernelAvx512();
+    case SimdLevel::Avx2:
+        return hashKernelAvx2();
+    default:
+        break;
+    }
+#endif
+    (void)level;
+    return swarHash<WordOps, WordOps>;
+}
+
+NeighborKernel neighborKernel(SimdLevel level)
+{
+#if GOL_X86_SIMD
+    switch (level) {
+    case SimdLevel::Avx512:
+        return neighborKernelAvx512();
+    case SimdLevel::Avx2:
+        return neighborKernelAvx2();
+    default:
+        break;
+    }
+#endif
+    (void)level;
+    return swarNeighbors<WordOps, WordOps>;
+}
@@ -0,0 +1,81 @@
+// Conway's Game of Life
+// Copyright (c) 2025 Faraz Fallahi <fffaraz@gmail.com>
+
+#pragma once
+
+#include "Rule.hpp"
+
+#include <cstdint>
+
+// Runtime-dispatched row kernels. The AVX2 and AVX-512 variants live in their own
+// translation units built with per-file -mavx2 / -mavx512f flags, and the one to
+// use is picked once from cpuid, so a single portable binary still gets the wide
+// kernels on hardware that has them (no -march=native required).
+enum class SimdLevel {
+    Scalar,
+    Avx2,
+    Avx512,
+};
+
+// Highest level this CPU and OS support (cpuid + xgetbv), or Scalar off x86-64.
+SimdLevel detectSimdLevel();
+
+// Level the grid kernels use: the detected level, optionally lowered by the
+// GOL_SIMD environment variable (scalar, avx2 or avx512) or setSimdLevel().
+SimdLevel activeSimdLevel();
+
+// Request a kernel level; it is clamped to detectSimdLevel(). Returns the level
+// now in effect. Not meant to be called while a grid update is running.
+SimdLevel setSimdLevel(SimdLevel level);
+
+const char* simdLevelName(SimdLevel level);
+
+// Cells born (dead in mid, alive in out) and died over some rows' words.
+struct RowCounts {
+    uint64_t births = 0;
+    uint64_t deaths = 0;
+};
+
+// Evaluate one row of `words` words: top/mid/bot are the rows above, at and below
+// the output row (a zero row past the grid edge). Unless `changed` is null, the
+// kernel also sets bit w of it for each word w of out it changes, i.e. whose new
+// value differs from the one it overwrites. Unless `counts` is null, it adds the
+// row's births and deaths to it, popcounted from the words still in registers.
+using RowKernel = void (*)(const uint64_t* top, const uint64_t* mid, const uint64_t* bot, uint64_t* out, int words, const Rule& rule, uint64_t* changed, RowCounts* counts);
+
+// Kernel for `level`, rows of `words` words and `rule`. Only pass the returned
+// kernel rows of that width and that rule: common widths and the NAMED_RULES get
+// their own specialization. words == 0 returns the runtime-width kernel, which
+// takes rows (or spans of rows) of any width.
+RowKernel rowKernel(SimdLevel level, int words, const Rule& rule);
+
+// Evaluate a column of `rows` rows that are one word wide. mid holds the column's
+// rows -1 .. rows (the rows above and below included, rows + 2 words), west/east
+// the same rows of the words to its left and right.
+using ColumnKernel = void (*)(const uint64_t* west, const uint64_t* mid, const uint64_t* east, uint64_t* out, int rows, const Rule& rule);
+
+ColumnKernel columnKernel(SimdLevel level, const Rule& rule);
+
+// Add the births and deaths turning `words` words of before into after to counts.
+using CountKernel = void (*)(const uint64_t* before, const uint64_t* after, int words, RowCounts& counts);
+
+CountKernel countKernel(SimdLevel level);
+
+// The share of `count` words, the first at position `first` of the grid, in a
+// grid's content hash (DynamicGrid::contentHash): NH, the hash of UMAC, under
+// two keys. Each word plus its key is split into halves that are multiplied
+// (one 32 x 32-bit vector multiply for several words) and summed, the keys
+// stepping through Weyl sequences over the positions; with two keys different
+// grids agree with odds of about 2^-64. A sum, so shares of any split of the
+// words add up to the same hash, and every level returns the same value.
+using HashKernel = uint64_t (*)(const uint64_t* words, int count, uint64_t first);
+
+HashKernel hashKernel(SimdLevel level);
+
+// Each cell's live-neighbor count (0..8) for one row of `words` words, as four
+// bit-planes: bit i of planes[k * words + w] is bit k of the count of cell
+// 64 * w + i. top/mid/bot are as for RowKernel; zeros shift in past the row's
+// first and last word.
+using NeighborKernel = void (*)(const uint64_t* top, const uint64_t* mid, const uint64_t* bot, uint64_t* planes, int words);
+
+NeighborKernel neighborKernel(SimdLevel level);
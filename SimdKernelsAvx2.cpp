@@ -0,0 +1,85 @@
+// Conway's Game of Life
+// Copyright (c) 2025 Faraz Fallahi <fffaraz@gmail.com>
+//
+// AVX2 row kernel: 4 words (256 cells) per step. Built with -mavx2 (/arch:AVX2)
+// and only ever called after SimdKernels.cpp has checked cpuid.
+
+#include "SwarKernel.hpp"
+
+#include <immintrin.h>
+
+namespace {
+
+struct Avx2Ops {
+    using V = __m256i;
+    static constexpr int LANES = 4;
+    static V load(const uint64_t* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+    static void store(uint64_t* p, V v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+    static V and_(V a, V b) { return _mm256_and_si256(a, b); }
+    static V or_(V a, V b) { return _mm256_or_si256(a, b); }
+    static V xor_(V a, V b) { return _mm256_xor_si256(a, b); }
+    static V andnot(V a, V b) { return _mm256_andnot_si256(a, b); }
+    static V not_(V a) { return _mm256_xor_si256(a, _mm256_set1_epi64x(-1)); }
+    static V broadcast(uint64_t w) { return _mm256_set1_epi64x(static_cast<long long>(w)); }
+    static V xor3(V a, V b, V c) { return xor_(xor_(a, b), c); }
+    static V maj(V a, V b, V c) { return or_(and_(a, b), and_(c, or_(a, b))); }
+    static V mux(V s, V a, V b) { return xor_(a, and_(s, xor_(a, b))); }
+    static V xorAnd(V a, V b, V c) { return xor_(a, and_(b, c)); }
+    static V shiftInPrev(V c, V p) { return or_(_mm256_slli_epi64(c, 1), _mm256_srli_epi64(p, 63)); }
+    static V shiftInNext(V c, V n) { return or_(_mm256_srli_epi64(c, 1), _mm256_slli_epi64(n, 63)); }
+    // [0, c0, c1, c2] and [c1, c2, c3, 0]: rotate the lanes, then blend a zero in.
+    static V edgePrev(V c) { return _mm256_blend_epi32(_mm256_permute4x64_epi64(c, 0x93), _mm256_setzero_si256(), 0x03); }
+    static V edgeNext(V c) { return _mm256_blend_epi32(_mm256_permute4x64_epi64(c, 0x39), _mm256_setzero_si256(), 0xC0); }
+    static unsigned differ(V a, V b) { return 0xFu ^ static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(a, b)))); }
+    // Per-byte counts from a nibble lookup table (vpshufb), totaled with vpsadbw.
+    static V bitCounts(V a)
+    {
+        const V table = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+        const V low = _mm256_set1_epi8(0x0F);
+        return _mm256_add_epi8(_mm256_shuffle_epi8(table, and_(a, low)), _mm256_shuffle_epi8(table, and_(_mm256_srli_epi64(a, 4), low)));
+    }
+    static V addCounts(V a, V b) { return _mm256_add_epi8(a, b); }
+    static uint64_t sumCounts(V a)
+    {
+        const V sums = _mm256_sad_epu8(a, _mm256_setzero_si256());
+        return static_cast<uint64_t>(_mm256_extract_epi64(sums, 0) + _mm256_extract_epi64(sums, 1) + _mm256_extract_epi64(sums, 2) + _mm256_extract_epi64(sums, 3));
+    }
+    static V add64(V a, V b) { return _mm256_add_epi64(a, b); }
+    // Low half times high half of each lane (vpmuludq).
+    static V mulHalves(V a) { return _mm256_mul_epu32(a, _mm256_srli_epi64(a, 32)); }
+    static uint64_t sum64(V a)
+    {
+        return static_cast<uint64_t>(_mm256_extract_epi64(a, 0)) + static_cast<uint64_t>(_mm256_extract_epi64(a, 1)) + static_cast<uint64_t>(_mm256_extract_epi64(a, 2))
+            + static_cast<uint64_t>(_mm256_extract_epi64(a, 3));
+    }
+};
+
+struct Avx2Tag { };
+using ScalarOps = WordOpsT<Avx2Tag>;
+
+} // namespace
+
+RowKernel rowKernelAvx2(int words, const Rule& rule)
+{
+    return selectRowKernel<Avx2Ops, ScalarOps>(words, rule);
+}
+
+ColumnKernel columnKernelAvx2(const Rule& rule)
+{
+    return selectColumnKernel<Avx2Ops, ScalarOps>(rule);
+}
+
+CountKernel countKernelAvx2()
+{
+    return swarCount<Avx2Ops, ScalarOps>;
+}
+
+HashKernel hashKernelAvx2()
+{
+    return swarHash<Avx2Ops, ScalarOps>;
+}
+
+NeighborKernel neighborKernelAvx2()
+{
+    return swarNeighbors<Avx2Ops, ScalarOps>;
+}
@@ -0,0 +1,104 @@
+// Conway's Game of Life
+// Copyright (c) 2025 Faraz Fallahi <fffaraz@gmail.com>
+//
+// AVX-512 row kernel: 8 words (512 cells) per step. Built with -mavx512f
+// (/arch:AVX512) and only ever called after SimdKernels.cpp has checked cpuid.
+// vpternlogq folds each full adder's sum and carry into one instruction apiece,
+// and each of a generic rule's selects too.
+
+#include "SwarKernel.hpp"
+
+// GCC 12's AVX-512 shift and multiply intrinsics pass _mm512_undefined_epi32()
+// as the unused merge source, which -Wmaybe-uninitialized then reports at every
+// inlined _mm512_slli_epi64, _mm512_srli_epi64 and _mm512_mul_epu32 (thousands
+// of times over, once swarHash and the counters instantiate them): a false
+// positive in the header.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#endif
+
+#include <immintrin.h>
+
+namespace {
+
+struct Avx512Ops {
+    using V = __m512i;
+    static constexpr int LANES = 8;
+    static V load(const uint64_t* p) { return _mm512_loadu_si512(p); }
+    static void store(uint64_t* p, V v) { _mm512_storeu_si512(p, v); }
+    static V and_(V a, V b) { return _mm512_and_si512(a, b); }
+    static V or_(V a, V b) { return _mm512_or_si512(a, b); }
+    static V xor_(V a, V b) { return _mm512_xor_si512(a, b); }
+    static V andnot(V a, V b) { return _mm512_andnot_si512(a, b); }
+    static V not_(V a) { return _mm512_ternarylogic_epi64(a, a, a, 0x55); }
+    static V broadcast(uint64_t w) { return _mm512_set1_epi64(static_cast<long long>(w)); }
+    static V xor3(V a, V b, V c) { return _mm512_ternarylogic_epi64(a, b, c, 0x96); }
+    static V maj(V a, V b, V c) { return _mm512_ternarylogic_epi64(a, b, c, 0xE8); }
+    static V mux(V s, V a, V b) { return _mm512_ternarylogic_epi64(s, b, a, 0xCA); }
+    static V xorAnd(V a, V b, V c) { return _mm512_ternarylogic_epi64(a, b, c, 0x78); }
+    static V shiftInPrev(V c, V p) { return or_(_mm512_slli_epi64(c, 1), _mm512_srli_epi64(p, 63)); }
+    static V shiftInNext(V c, V n) { return or_(_mm512_srli_epi64(c, 1), _mm512_slli_epi64(n, 63)); }
+    // [0, c0..c6] and [c1..c7, 0]: valignq against a zero vector.
+    static V edgePrev(V c) { return _mm512_alignr_epi64(c, _mm512_setzero_si512(), 7); }
+    static V edgeNext(V c) { return _mm512_alignr_epi64(_mm512_setzero_si512(), c, 1); }
+    static unsigned differ(V a, V b) { return _mm512_cmpneq_epi64_mask(a, b); }
+    // Per-byte counts by the usual SWAR halving steps: vpopcntq and the byte
+    // shuffles/sums need extensions beyond AVX-512F.
+    static V bitCounts(V a)
+    {
+        const V pairs = _mm512_sub_epi64(a, and_(_mm512_srli_epi64(a, 1), broadcast(0x5555555555555555ULL)));
+        const V m2 = broadcast(0x3333333333333333ULL);
+        const V nibbles = _mm512_add_epi64(and_(pairs, m2), and_(_mm512_srli_epi64(pairs, 2), m2));
+        return and_(_mm512_add_epi64(nibbles, _mm512_srli_epi64(nibbles, 4)), broadcast(0x0F0F0F0F0F0F0F0FULL));
+    }
+    // Bytes stay below 256 (see COUNT_BATCH), so 64-bit adds never carry across them.
+    static V addCounts(V a, V b) { return _mm512_add_epi64(a, b); }
+    static uint64_t sumCounts(V a)
+    {
+        const V m8 = broadcast(0x00FF00FF00FF00FFULL);
+        V sums = _mm512_add_epi64(and_(a, m8), and_(_mm512_srli_epi64(a, 8), m8));
+        sums = _mm512_add_epi64(sums, _mm512_srli_epi64(sums, 16));
+        sums = _mm512_add_epi64(sums, _mm512_srli_epi64(sums, 32));
+        return static_cast<uint64_t>(_mm512_reduce_add_epi64(and_(sums, broadcast(0xFFFF))));
+    }
+    static V add64(V a, V b) { return _mm512_add_epi64(a, b); }
+    // Low half times high half of each lane (vpmuludq).
+    static V mulHalves(V a) { return _mm512_mul_epu32(a, _mm512_srli_epi64(a, 32)); }
+    static uint64_t sum64(V a) { return static_cast<uint64_t>(_mm512_reduce_add_epi64(a)); }
+};
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+struct Avx512Tag { };
+using ScalarOps = WordOpsT<Avx512Tag>;
+
+} // namespace
+
+RowKernel rowKernelAvx512(int words, const Rule& rule)
+{
+    return selectRowKernel<Avx512Ops, ScalarOps>(words, rule);
+}
+
+ColumnKernel columnKernelAvx512(const Rule& rule)
+{
+    return selectColumnKernel<Avx512Ops, ScalarOps>(rule);
+}
+
+CountKernel countKernelAvx512()
+{
+    return swarCount<Avx512Ops, ScalarOps>;
+}
+
+HashKernel hashKernelAvx512()
+{
+    return swarHash<Avx512Ops, ScalarOps>;
+}
+
+NeighborKernel neighborKernelAvx512()
+{
+    return swarNeighbors<Avx512Ops, ScalarOps>;
+}
@@ -0,0 +1,243 @@
+// Conway's Game of Life
+// Copyright (c) 2025 Faraz Fallahi <fffaraz@gmail.com>
+
+#include "SparseLife.hpp"
+#include "Grid.hpp"
+#include "SimdKernels.hpp"
+
+#include <algorithm>
+#include <bit> // std::popcount
+#include <stdexcept>
+
+struct SparseLife::Tile {
+    int64_t tx;
+    int64_t ty;
+    uint64_t cur[TILE];
+    uint64_t next[TILE];
+    // The 3x3 block of tiles centered on this one (NW, N, NE, W, this, E, SW,
+    // S, SE), null where there is none; kept up to date as tiles come and go.
+    Tile* around[9];
+    bool changed = true; // differs from the previous generation
+    uint64_t queued = 0; // generation this tile was last put on the step list
+};
+
+namespace {
+
+constexpr int TILE = SparseLife::TILE;
+
+} // namespace
+
+std::size_t SparseLife::TileKeyHash::operator()(const TileKey& key) const
+{
+    const uint64_t h = static_cast<uint64_t>(key.first) * 0x9E3779B97F4A7C15ULL;
+    return static_cast<std::size_t>((h ^ static_cast<uint64_t>(key.second)) * 0xC2B2AE3D27D4EB4FULL >> 16);
+}
+
+SparseLife::SparseLife(const Rule& rule)
+    : rule_(rule)
+{
+    if (rule.birth & 1) {
+        throw std::invalid_argument("SparseLife cannot run B0 rules");
+    }
+}
+
+SparseLife::~SparseLife() = default;
+
+SparseLife::Tile* SparseLife::find(int64_t tx, int64_t ty) const
+{
+    const auto it = tiles_.find(TileKey { tx, ty });
+    return it == tiles_.end() ? nullptr : it->second.get();
+}
+
+SparseLife::Tile& SparseLife::tileAt(int64_t tx, int64_t ty)
+{
+    auto& tile = tiles_[TileKey { tx, ty }];
+    if (!tile) {
+        tile = std::make_unique<Tile>();
+        tile->tx = tx;
+        tile->ty = ty;
+        std::fill(tile->cur, tile->cur + TILE, 0);
+        for (int i = 0; i < 9; ++i) {
+            Tile* n = i == 4 ? tile.get() : find(tx + (i / 3) - 1, ty + (i % 3) - 1);
+            tile->around[i] = n;
+            if (n != nullptr) {
+                n->around[8 - i] = tile.get();
+            }
+        }
+    }
+    return *tile;
+}
+
+void SparseLife::erase(Tile* tile)
+{
+    for (int i = 0; i < 9; ++i) {
+        if (tile->around[i] != nullptr) {
+            tile->around[i]->around[8 - i] = nullptr;
+        }
+    }
+    tiles_.erase(TileKey { tile->tx, tile->ty });
+}
+
+void SparseLife::clear()
+{
+    tiles_.clear();
+    stepList_.clear();
+    generation_ = 0;
+}
+
+bool SparseLife::get(int64_t x, int64_t y) const
+{
+    const Tile* t = find(x >> 6, y >> 6);
+    return t != nullptr && ((t->cur[x & 63] >> (y & 63)) & 1);
+}
+
+void SparseLife::set(int64_t x, int64_t y, bool alive)
+{
+    Tile* t = alive ? &tileAt(x >> 6, y >> 6) : find(x >> 6, y >> 6);
+    if (t != nullptr) {
+        const uint64_t bit = 1ULL << (y & 63);
+        uint64_t& row = t->cur[x & 63];
+        row = alive ? (row | bit) : (row & ~bit);
+        t->changed = true;
+    }
+}
+
+void SparseLife::fromGrid(const DynamicGrid& grid)
+{
+    clear();
+    for (int64_t tx = 0; tx * TILE < grid.height(); ++tx) {
+        for (int64_t ty = 0; ty * TILE < grid.width(); ++ty) {
+            uint64_t rows[TILE] = {};
+            uint64_t any = 0;
+            for (int r = 0; r < TILE && tx * TILE + r < grid.height(); ++r) {
+                for (int c = 0; c < TILE && ty * TILE + c < grid.width(); ++c) {
+                    if (grid.get({ static_cast<int>(tx * TILE + r), static_cast<int>(ty * TILE + c) })) {
+                        rows[r] |= 1ULL << c;
+                    }
+                }
+                any |= rows[r];
+            }
+            if (any != 0) {
+                std::copy(rows, rows + TILE, tileAt(tx, ty).cur);
+            }
+        }
+    }
+}
+
+void SparseLife::toGrid(DynamicGrid& grid, int64_t x0, int64_t y0) const
+{
+    grid.clear();
+    for (const auto& [key, tile] : tiles_) {
+        for (int r = 0; r < TILE; ++r) {
+            const int64_t x = (tile->tx * TILE) + r - x0;
+            if (x < 0 || x >= grid.height()) {
+                continue;
+            }
+            for (uint64_t row = tile->cur[r]; row != 0; row &= row - 1) {
+                const int64_t y = (tile->ty * TILE) + std::countr_zero(row) - y0;
+                if (y >= 0 && y < grid.width()) {
+                    grid.set({ static_cast<int>(x), static_cast<int>(y) }, true);
+                }
+            }
+        }
+    }
+}
+
+uint64_t SparseLife::population() const
+{
+    uint64_t total = 0;
+    for (const auto& [key, tile] : tiles_) {
+        for (const uint64_t row : tile->cur) {
+            total += static_cast<uint64_t>(std::popcount(row));
+        }
+    }
+    return total;
+}
+
+// One generation. A tile that did not change last generation, and whose
+// neighbors did not either, sees exactly the inputs it saw then and so would
+// reproduce its current state: only changed tiles and their neighbors are
+// stepped. A missing neighbor is only created when live cells touch that side,
+// since without B0 nothing can be born out of an all-dead neighborhood.
+void SparseLife::advance()
+{
+    const uint64_t stamp = generation_ + 1;
+    std::vector<Tile*> active;
+    for (const auto& [key, tile] : tiles_) {
+        if (tile->changed) {
+            active.push_back(tile.get());
+        }
+    }
+
+    stepList_.clear();
+    const auto queue = [&](Tile* t) {
+        if (t->queued != stamp) {
+            t->queued = stamp;
+            stepList_.push_back(t);
+        }
+    };
+    for (Tile* t : active) {
+        uint64_t sides = 0;
+        for (const uint64_t row : t->cur) {
+            sides |= row;
+        }
+        const uint64_t top = t->cur[0];
+        const uint64_t bottom = t->cur[TILE - 1];
+        for (int i = 0; i < 9; ++i) {
+            const int dx = (i / 3) - 1;
+            const int dy = (i % 3) - 1;
+            // Live cells on the side facing that neighbor.
+            const uint64_t edgeRow = dx < 0 ? top : (dx > 0 ? bottom : sides);
+            const uint64_t mask = dy < 0 ? 1ULL : (dy > 0 ? (1ULL << 63) : ~0ULL);
+            if (t->around[i] == nullptr && (edgeRow & mask) != 0) {
+                tileAt(t->tx + dx, t->ty + dy);
+            }
+            if (t->around[i] != nullptr) {
+                queue(t->around[i]);
+            }
+        }
+    }
+
+    // Each tile is a one-word-wide column whose left/right neighbor words are
+    // the W/E tiles' rows; rows -1 and 64 come from the tiles above and below.
+    const ColumnKernel kernel = columnKernel(activeSimdLevel(), rule_);
+    for (Tile* t : stepList_) {
+        uint64_t columns[3][TILE + 2];
+        for (int c = 0; c < 3; ++c) {
+            const Tile* above = t->around[c];
+            const Tile* side = t->around[3 + c];
+            const Tile* below = t->around[6 + c];
+            columns[c][0] = above != nullptr ? above->cur[TILE - 1] : 0;
+            columns[c][TILE + 1] = below != nullptr ? below->cur[0] : 0;
+            if (side != nullptr) {
+                std::copy(side->cur, side->cur + TILE, columns[c] + 1);
+            } else {
+                std::fill(columns[c] + 1, columns[c] + TILE + 1, 0);
+            }
+        }
+        kernel(columns[0], columns[1], columns[2], t->next, TILE, rule_);
+    }
+
+    for (Tile* t : stepList_) {
+        t->changed = !std::equal(t->next, t->next + TILE, t->cur);
+        std::copy(t->next, t->next + TILE, t->cur);
+    }
+    // Free tiles that are empty and will not be stepped next generation either;
+    // an empty tile next to activity is kept rather than freed and recreated.
+    for (Tile* t : stepList_) {
+        if (t->changed || std::any_of(t->cur, t->cur + TILE, [](uint64_t row) { return row != 0; })) {
+            continue;
+        }
+        if (std::none_of(t->around, t->around + 9, [](const Tile* n) { return n != nullptr && n->changed; })) {
+            erase(t);
+        }
+    }
+    ++generation_;
+}
+
+void SparseLife::step(uint64_t generations)
+{
+    for (uint64_t i = 0; i < generations; ++i) {
+        advance();
+    }
+}
@@ -0,0 +1,75 @@
+// Conway's Game of Life
+// Copyright (c) 2025 Faraz Fallahi <fffaraz@gmail.com>
+
+#pragma once
+
+#include "Rule.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class DynamicGrid;
+
+// Unbounded universe stored as a hash map of 64x64 tiles, each bit-packed like a
+// DynamicGrid row (one 64-bit word per tile row) and stepped with the SIMD
+// column kernel, lanes running down the tile. Only tiles that changed last
+// generation, and their neighbors, are stepped; a tile is allocated when live
+// cells reach its edge and freed once it is empty and stable. A few gliders on
+// an otherwise empty plane therefore cost a handful of tiles per generation,
+// however far apart they are: the work tracks the active population, not the
+// area.
+//
+// Cells are addressed like DynamicGrid (x row, y column); fromGrid() places a
+// grid at rows [0, height), columns [0, width). There are no edges, so results
+// match a Dead-boundary grid while the pattern stays clear of its edges.
+class SparseLife {
+public:
+    static constexpr int TILE = 64;
+
+    // Throws std::invalid_argument for a B0 rule, which would fill the empty
+    // plane (and so every tile) on the first generation.
+    explicit SparseLife(const Rule& rule = Rule {});
+    ~SparseLife();
+
+    const Rule& rule() const { return rule_; }
+    uint64_t generation() const { return generation_; }
+
+    // Replace the universe with grid's live cells; generation restarts at 0.
+    void fromGrid(const DynamicGrid& grid);
+    // Copy rows [x0, x0 + height) and columns [y0, y0 + width) of the universe
+    // into grid; everything outside that window is left out.
+    void toGrid(DynamicGrid& grid, int64_t x0 = 0, int64_t y0 = 0) const;
+
+    bool get(int64_t x, int64_t y) const;
+    void set(int64_t x, int64_t y, bool alive);
+    void clear();
+
+    void step(uint64_t generations = 1);
+
+    uint64_t population() const;
+    std::size_t tileCount() const { return tiles_.size(); }
+    // Tiles stepped by the last generation.
+    std::size_t steppedTiles() const { return stepList_.size(); }
+
+private:
+    struct Tile;
+    // Tiles by (tx, ty), both in full: the plane spans all 64-bit coordinates.
+    using TileKey = std::pair<int64_t, int64_t>;
+    struct TileKeyHash {
+        std::size_t operator()(const TileKey& key) const;
+    };
+
+    Rule rule_;
+    std::unordered_map<TileKey, std::unique_ptr<Tile>, TileKeyHash> tiles_;
+    std::vector<Tile*> stepList_;
+    uint64_t generation_ = 0;
+
+    Tile* find(int64_t tx, int64_t ty) const;
+    Tile& tileAt(int64_t tx, int64_t ty);
+    void erase(Tile* tile);
+    void advance();
+};
@@ -0,0 +1,125 @@
+// Conway's Game of Life
+// Copyright (c) 2025 Faraz Fallahi <fffaraz@gmail.com>
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#include <immintrin.h>
+#endif
+
+// Tell the core we are busy-waiting: frees pipeline resources for a hyperthread
+// sibling and saves power without giving up the time slice.
+inline void cpuRelax()
+{
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    _mm_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+// Spin-then-park wait until `value` no longer holds `old`; returns the new
+// value. Spinning for up to `spin` catches a change that comes within a few
+// microseconds (the next generation of a small grid) without a futex sleep and
+// wake-up, which cost more than the whole generation; past the budget the
+// thread parks in atomic::wait so an idle pool burns no CPU. A parked waiter
+// counts itself in `parked`, which the writer checks to skip the wake-up
+// syscall when nobody sleeps; both sides use sequentially consistent order so
+// that a waiter either sees the new value or is seen parked.
+template <typename T>
+T spinThenWait(const std::atomic<T>& value, const T old, std::chrono::nanoseconds spin, std::atomic<int>& parked)
+{
+    constexpr int SPINS_PER_CLOCK_CHECK = 64;
+    if (spin.count() > 0) {
+        const auto deadline = std::chrono::steady_clock::now() + spin;
+        do {
+            for (int i = 0; i < SPINS_PER_CLOCK_CHECK; ++i) {
+                const T v = value.load(std::memory_order_acquire);
+                if (v != old) {
+                    return v;
+                }
+                cpuRelax();
+            }
+        } while (std::chrono::steady_clock::now() < deadline);
+    }
+    T v = value.load(std::memory_order_acquire);
+    while (v == old) {
+        parked.fetch_add(1, std::memory_order_seq_cst);
+        value.wait(old, std::memory_order_seq_cst);
+        parked.fetch_sub(1, std::memory_order_relaxed);
+        v = value.load(std::memory_order_acquire);
+    }
+    return v;
+}
+
+// Wake the waiters of `value` after changing it, if any are parked.
+template <typename T>
+void wakeParked(std::atomic<T>& value, const std::atomic<int>& parked)
+{
+    if (parked.load(std::memory_order_seq_cst) > 0) {
+        value.notify_all();
+    }
+}
+
+// The pass barrier of BandExecutor, as one phase flip per pass instead of a
+// start and an end barrier. The coordinator starts a pass by bumping the
+// phase, which releases the workers; each worker checks out by counting down
+// the pending workers and goes straight back to waiting for the next phase,
+// and only the coordinator waits for the count to reach zero. Workers thus
+// sync once per pass, and every wait is spin-then-park.
+class SpinBarrier {
+public:
+    explicit SpinBarrier(std::chrono::nanoseconds spin)
+        : spin_(spin.count())
+    {
+    }
+
+    SpinBarrier(const SpinBarrier&) = delete;
+    SpinBarrier& operator=(const SpinBarrier&) = delete;
+
+    // How long waits spin before parking; changeable at any time.
+    std::chrono::nanoseconds spin() const { return std::chrono::nanoseconds(spin_.load(std::memory_order_relaxed)); }
+    void setSpin(std::chrono::nanoseconds spin) { spin_.store(spin.count(), std::memory_order_relaxed); }
+
+    // Coordinator: start a pass for `workers` workers. Everything written
+    // before is visible to them once they return from waitStart.
+    void release(int workers)
+    {
+        pending_.store(workers, std::memory_order_relaxed);
+        phase_.fetch_add(1, std::memory_order_seq_cst);
+        wakeParked(phase_, parkedWorkers_);
+    }
+    // Coordinator: wait until every worker has called done(); their writes
+    // are then visible.
+    void waitDone()
+    {
+        int pending = pending_.load(std::memory_order_acquire);
+        while (pending != 0) {
+            pending = spinThenWait(pending_, pending, spin(), parkedCoordinator_);
+        }
+    }
+
+    // Worker: wait for the pass after the one numbered `seen`, and return its
+    // number (pass for the next call).
+    uint64_t waitStart(const uint64_t seen) { return spinThenWait(phase_, seen, spin(), parkedWorkers_); }
+    // Worker: this pass's work is done.
+    void done()
+    {
+        if (pending_.fetch_sub(1, std::memory_order_seq_cst) == 1) {
+            wakeParked(pending_, parkedCoordinator_);
+        }
+    }
+
+private:
+    // Each on its own cache line: workers poll phase_ while pending_ is
+    // counted down.
+    alignas(64) std::atomic<uint64_t> phase_ { 0 };
+    alignas(64) std::atomic<int> pending_ { 0 };
+    alignas(64) std::atomic<int> parkedWorkers_ { 0 };
+    std::atomic<int> parkedCoordinator_ { 0 };
+    std::atomic<std::chrono::nanoseconds::rep> spin_;
+};
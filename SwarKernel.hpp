@@ -0,0 +1,647 @@
+// Conway's Game of Life
+// Copyright (c) 2025 Faraz Fallahi <fffaraz@gmail.com>
+
+#pragma once
+
+#include "Rule.hpp"
+#include "SimdKernels.hpp"
+
+#include <bit> // std::popcount
+#include <cstdint>
+#include <utility> // std::index_sequence
+
+// The SWAR life kernel, written once against a small "lane ops" interface so the
+// same full/half-adder network runs on plain 64-bit words and on 256/512-bit SIMD
+// registers. An Ops type provides:
+//   V, LANES                  lane type and how many 64-bit words it holds
+//   load/store                unaligned access to LANES consecutive words
+//   and_/or_/xor_/andnot/not_ bitwise ops; andnot(a, b) = ~a & b
+//   broadcast                 a 64-bit word repeated in every lane
+//   xor3/maj                  full-adder sum and carry of three planes
+//   mux/xorAnd                mux(s, a, b) = s ? b : a per bit, and a ^ (b & c):
+//                             the generic rule's selects, one instruction each
+//                             where the ISA has three-input logic
+//   shiftInPrev/shiftInNext   per-64-bit-lane << 1 / >> 1, carrying in the
+//                             neighboring word's edge bit
+//   edgePrev/edgeNext         the chunk moved up/down one lane with a zero word
+//                             entering, i.e. its previous/next words at the
+//                             row's left/right edge
+//   differ                    bit i set where lane i of the two chunks differs
+//   bitCounts/addCounts/      population count in two stages: bitCounts turns a
+//     sumCounts               chunk into small partial counts (per lane or per
+//                             byte), addCounts sums up to COUNT_BATCH of those
+//                             without overflow, sumCounts totals a sum
+// Inside a row each lane's neighbor word comes from a load offset by one word, so
+// the cross-lane carry is just another load; only a row's first and last chunk
+// build it with a lane shuffle instead.
+
+// The per-chunk steps must inline into the row loop (they are what keeps the
+// planes and rule constants in registers), but a generic rule makes them big
+// enough that the compiler's own heuristics may decline.
+#if defined(_MSC_VER)
+#define SWAR_INLINE __forceinline
+#else
+#define SWAR_INLINE inline __attribute__((always_inline))
+#endif
+
+// Scalar lane ops. Templated on a tag so each ISA translation unit can instantiate
+// a private copy (compiled with its own -m flags) that the linker never folds into
+// the baseline build.
+template <typename Tag>
+struct WordOpsT {
+    using V = uint64_t;
+    static constexpr int LANES = 1;
+    static V load(const uint64_t* p) { return *p; }
+    static void store(uint64_t* p, V v) { *p = v; }
+    static V and_(V a, V b) { return a & b; }
+    static V or_(V a, V b) { return a | b; }
+    static V xor_(V a, V b) { return a ^ b; }
+    static V andnot(V a, V b) { return ~a & b; }
+    static V not_(V a) { return ~a; }
+    static V broadcast(uint64_t w) { return w; }
+    static V xor3(V a, V b, V c) { return a ^ b ^ c; }
+    static V maj(V a, V b, V c) { return (a & b) | (c & (a | b)); }
+    static V mux(V s, V a, V b) { return a ^ (s & (a ^ b)); }
+    static V xorAnd(V a, V b, V c) { return a ^ (b & c); }
+    static V shiftInPrev(V c, V p) { return (c << 1) | (p >> 63); }
+    static V shiftInNext(V c, V n) { return (c >> 1) | (n << 63); }
+    static V edgePrev(V) { return 0; }
+    static V edgeNext(V) { return 0; }
+    static unsigned differ(V a, V b) { return a != b ? 1u : 0u; }
+    // Without a popcnt instruction (the portable baseline build) std::popcount is
+    // a library call, so count per byte and fold the bytes once per batch instead.
+#ifdef __POPCNT__
+    static V bitCounts(V a) { return static_cast<V>(std::popcount(a)); }
+    static uint64_t sumCounts(V a) { return a; }
+#else
+    static V bitCounts(V a)
+    {
+        a -= (a >> 1) & 0x5555555555555555ULL;
+        a = (a & 0x3333333333333333ULL) + ((a >> 2) & 0x3333333333333333ULL);
+        return (a + (a >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    }
+    static uint64_t sumCounts(V a)
+    {
+        a = (a & 0x00FF00FF00FF00FFULL) + ((a >> 8) & 0x00FF00FF00FF00FFULL);
+        return (a * 0x0001000100010001ULL) >> 48;
+    }
+#endif
+    static V addCounts(V a, V b) { return a + b; }
+    static V add64(V a, V b) { return a + b; }
+    static V mulHalves(V a) { return (a & 0xFFFFFFFFULL) * (a >> 32); }
+    static uint64_t sum64(V a) { return a; }
+};
+using WordOps = WordOpsT<void>;
+
+// The Weyl sequence steps of swarHash's two keys, and the odd constant its
+// second sum is folded in with.
+constexpr uint64_t HASH_STEP1 = 0x9e3779b97f4a7c15ULL;
+constexpr uint64_t HASH_STEP2 = 0xd1b54a32d192ed03ULL;
+constexpr uint64_t HASH_MIX = 0xff51afd7ed558ccdULL;
+// Lane i's head start on the keys: i steps, for up to 8 lanes.
+alignas(64) inline constexpr uint64_t HASH_LANE_STEPS1[8] = { 0, HASH_STEP1, 2 * HASH_STEP1, 3 * HASH_STEP1, 4 * HASH_STEP1, 5 * HASH_STEP1, 6 * HASH_STEP1, 7 * HASH_STEP1 };
+alignas(64) inline constexpr uint64_t HASH_LANE_STEPS2[8] = { 0, HASH_STEP2, 2 * HASH_STEP2, 3 * HASH_STEP2, 4 * HASH_STEP2, 5 * HASH_STEP2, 6 * HASH_STEP2, 7 * HASH_STEP2 };
+
+// Chunks whose bitCounts one addCounts sum may hold: per-byte counts reach 8 per
+// chunk, so 31 chunks stay below 256.
+constexpr int COUNT_BATCH = 31;
+
+// Bit-sliced rule evaluation. The adder network below leaves each column's
+// neighbor count in bit-planes s0..s3 (s3 only set for a count of 8); a rule maps
+// those planes plus the cell itself to the next state. Two implementations, both
+// with a per-Ops Eval type whose operator() does the mapping for one chunk:
+//   StaticRule<R>  R is a template argument; its truth table is folded into a
+//                  minimal-ish bitwise expression at compile time.
+//   GenericRule    any Rule at runtime, as a mux tree over a broadcast truth table.
+//                  A rule whose count 8 acts like count 0 gets GenericRuleT<false>,
+//                  which leaves out the count-8 correction (and so s3).
+
+// Truth table of next state over (s2, s1, s0, self), index s2<<3 | s1<<2 | s0<<1 |
+// self, i.e. for neighbor counts 0..7. A count of 8 reads as 0 in those planes.
+constexpr uint32_t ruleTable(const Rule& rule)
+{
+    uint32_t table = 0;
+    for (int i = 0; i < 16; ++i) {
+        table |= static_cast<uint32_t>(rule.next(i & 1, i >> 1)) << i;
+    }
+    return table;
+}
+
+// Where a count of 8 differs from a count of 0, indexed by self: the mask s3
+// XORs into the result.
+constexpr uint32_t ruleEightFix(const Rule& rule)
+{
+    return (rule.next(false, 0) != rule.next(false, 8) ? 1u : 0u) | (rule.next(true, 0) != rule.next(true, 8) ? 2u : 0u);
+}
+
+// Expression for the VARS-input boolean function TABLE, by Shannon expansion on
+// the top variable x[VARS-1] with every constant or repeated cofactor folded
+// away. For B3/S23 this yields exactly s1 & ~s2 & (s0 | self).
+template <typename Ops, uint32_t TABLE, int VARS>
+inline typename Ops::V ruleExpr(const typename Ops::V* x)
+{
+    using V = typename Ops::V;
+    constexpr uint32_t FULL = (1u << (1 << VARS)) - 1;
+    if constexpr (TABLE == 0) {
+        return Ops::xor_(x[0], x[0]);
+    } else if constexpr (TABLE == FULL) {
+        return Ops::not_(Ops::xor_(x[0], x[0]));
+    } else {
+        constexpr int HALF = 1 << (VARS - 1);
+        constexpr uint32_t SUB = (1u << HALF) - 1;
+        constexpr uint32_t F0 = TABLE & SUB; // top variable clear
+        constexpr uint32_t F1 = TABLE >> HALF; // top variable set
+        const V v = x[VARS - 1];
+        if constexpr (F0 == F1) {
+            return ruleExpr<Ops, F0, VARS - 1>(x);
+        } else if constexpr (F0 == 0) {
+            return Ops::and_(v, ruleExpr<Ops, F1, VARS - 1>(x));
+        } else if constexpr (F1 == 0) {
+            return Ops::andnot(v, ruleExpr<Ops, F0, VARS - 1>(x));
+        } else if constexpr (F1 == SUB) {
+            return Ops::or_(v, ruleExpr<Ops, F0, VARS - 1>(x));
+        } else if constexpr (F0 == SUB) {
+            return Ops::not_(Ops::andnot(ruleExpr<Ops, F1, VARS - 1>(x), v));
+        } else if constexpr ((F0 ^ F1) == SUB) {
+            return Ops::xor_(v, ruleExpr<Ops, F0, VARS - 1>(x));
+        } else {
+            const V f0 = ruleExpr<Ops, F0, VARS - 1>(x);
+            return Ops::xor_(f0, Ops::and_(v, Ops::xor_(f0, ruleExpr<Ops, F1, VARS - 1>(x))));
+        }
+    }
+}
+
+template <Rule R>
+struct StaticRule {
+    template <typename Ops>
+    struct Eval {
+        using V = typename Ops::V;
+        explicit Eval(const Rule&) { }
+        SWAR_INLINE V operator()(V s0, V s1, V s2, V s3, V self) const
+        {
+            const V x[4] = { self, s0, s1, s2 };
+            const V next = ruleExpr<Ops, ruleTable(R), 4>(x);
+            constexpr uint32_t FIX = ruleEightFix(R);
+            if constexpr (FIX == 0) {
+                return next;
+            } else if constexpr (FIX == 1) {
+                return Ops::xor_(next, Ops::andnot(self, s3));
+            } else if constexpr (FIX == 2) {
+                return Ops::xor_(next, Ops::and_(s3, self));
+            } else {
+                return Ops::xor_(next, s3);
+            }
+        }
+    };
+};
+
+template <bool EIGHT>
+struct GenericRuleT {
+    template <typename Ops>
+    struct Eval {
+        using V = typename Ops::V;
+        // Per neighbor count n: dn is the next state of a dead cell (0 or all
+        // ones), fn is dn ^ the next state of a live one. fix8/flip8 do the same
+        // for the count-8 correction (see ruleEightFix).
+        V d0, d1, d2, d3, d4, d5, d6, d7;
+        V f0, f1, f2, f3, f4, f5, f6, f7;
+        V fix8, flip8;
+
+        explicit Eval(const Rule& rule)
+        {
+            const auto lane = [](bool bit) { return Ops::broadcast(bit ? ~0ULL : 0ULL); };
+            V* const dead[8] = { &d0, &d1, &d2, &d3, &d4, &d5, &d6, &d7 };
+            V* const flip[8] = { &f0, &f1, &f2, &f3, &f4, &f5, &f6, &f7 };
+            for (int n = 0; n < 8; ++n) {
+                *dead[n] = lane(rule.next(false, n));
+                *flip[n] = lane(rule.next(false, n) != rule.next(true, n));
+            }
+            const uint32_t fix = ruleEightFix(rule);
+            fix8 = lane(fix & 1);
+            flip8 = lane(((fix >> 1) ^ fix) & 1);
+        }
+        // A mux tree over the count bits, with self folded in at the leaves.
+        // Written out in full so every constant stays in a register.
+        SWAR_INLINE V operator()(V s0, V s1, V s2, V s3, V self) const
+        {
+            const auto leaf = [self](V d, V f) { return Ops::xorAnd(d, self, f); };
+            const V q0 = Ops::mux(s0, leaf(d0, f0), leaf(d1, f1));
+            const V q1 = Ops::mux(s0, leaf(d2, f2), leaf(d3, f3));
+            const V q2 = Ops::mux(s0, leaf(d4, f4), leaf(d5, f5));
+            const V q3 = Ops::mux(s0, leaf(d6, f6), leaf(d7, f7));
+            const V next = Ops::mux(s2, Ops::mux(s1, q0, q1), Ops::mux(s1, q2, q3));
+            if constexpr (EIGHT) {
+                return Ops::xorAnd(next, s3, leaf(fix8, flip8));
+            } else {
+                return next;
+            }
+        }
+    };
+};
+using GenericRule = GenericRuleT<true>;
+
+// The binary neighbor count s3 s2 s1 s0 (0..8) of every column of the LANES
+// words at b. a/b/c are the rows above, at and below; P/C/N are the previous,
+// center and next word of each row. The 8 neighbors are summed via full/half
+// adders on bit-planes.
+template <typename Ops>
+struct NeighborSum {
+    typename Ops::V s0, s1, s2, s3;
+};
+
+template <typename Ops>
+SWAR_INLINE NeighborSum<Ops> neighborSum(
+    typename Ops::V aP, typename Ops::V aC, typename Ops::V aN,
+    typename Ops::V bP, typename Ops::V bC, typename Ops::V bN,
+    typename Ops::V cP, typename Ops::V cC, typename Ops::V cN)
+{
+    using V = typename Ops::V;
+
+    // Left/right neighbor bit-planes for each row.
+    const V aL = Ops::shiftInPrev(aC, aP);
+    const V aR = Ops::shiftInNext(aC, aN);
+    const V bL = Ops::shiftInPrev(bC, bP);
+    const V bR = Ops::shiftInNext(bC, bN);
+    const V cL = Ops::shiftInPrev(cC, cP);
+    const V cR = Ops::shiftInNext(cC, cN);
+
+    // Top row: sum of its 3 columns -> 2-bit value (t1 t0).
+    const V t0 = Ops::xor3(aL, aC, aR);
+    const V t1 = Ops::maj(aL, aC, aR);
+    // Bottom row: sum of its 3 columns -> (u1 u0).
+    const V u0 = Ops::xor3(cL, cC, cR);
+    const V u1 = Ops::maj(cL, cC, cR);
+    // Middle row: left + right only (self excluded) -> (v1 v0).
+    const V v0 = Ops::xor_(bL, bR);
+    const V v1 = Ops::and_(bL, bR);
+
+    // Add the three 2-bit numbers into the 0..8 total.
+    const V s0 = Ops::xor3(t0, u0, v0);
+    const V c0 = Ops::maj(t0, u0, v0);
+    const V hs = Ops::xor3(t1, u1, v1);
+    const V hc = Ops::maj(t1, u1, v1);
+    const V c1 = Ops::and_(hs, c0);
+    return { s0, Ops::xor_(hs, c0), Ops::xor_(hc, c1), Ops::and_(hc, c1) };
+}
+
+// One generation for LANES words: the neighbor count planes handed to the rule.
+// For Conway's rule that collapses to a single expression:
+//   next = s1 & ~s2 & (s0 | self)
+// i.e. alive next iff neighbor count is 2 (and self alive) or exactly 3; s3 is
+// never computed since 8 and 0 neighbors both mean death.
+template <typename Ops, typename Eval>
+SWAR_INLINE typename Ops::V lifeStep(
+    typename Ops::V aP, typename Ops::V aC, typename Ops::V aN,
+    typename Ops::V bP, typename Ops::V bC, typename Ops::V bN,
+    typename Ops::V cP, typename Ops::V cC, typename Ops::V cN,
+    const Eval& rule)
+{
+    const NeighborSum<Ops> n = neighborSum<Ops>(aP, aC, aN, bP, bC, bN, cP, cC, cN);
+    return rule(n.s0, n.s1, n.s2, n.s3, bC);
+}
+
+// lifeStep for the LANES words starting at w, all three rows read in place.
+// Callers guarantee w-1 and w+LANES are valid word indices.
+template <typename Ops, typename Eval>
+SWAR_INLINE typename Ops::V lifeStepAt(const uint64_t* a, const uint64_t* b, const uint64_t* c, int w, const Eval& rule)
+{
+    return lifeStep<Ops>(
+        Ops::load(a + w - 1), Ops::load(a + w), Ops::load(a + w + 1),
+        Ops::load(b + w - 1), Ops::load(b + w), Ops::load(b + w + 1),
+        Ops::load(c + w - 1), Ops::load(c + w), Ops::load(c + w + 1),
+        rule);
+}
+
+// Evaluate one row of `words` words into out under RuleT (StaticRule<R> or
+// GenericRule; `rule` is only read by the latter). a/c are the rows above and
+// below (a zero row past the grid's top/bottom edge); zeros also shift in past the
+// row's first and last word. The row runs VecOps::LANES words per step; a row
+// narrower than one step, or the remainder after the last full step, goes
+// through ScalarOps.
+// With TRACK, bit w of `changed` is set (never cleared) for each output word w
+// that differs from what out held before; with a lane compare per step this is
+// nearly free, as the old chunk is loaded just before the store anyway. The
+// bits collect in a register and are flushed every 64 words: steps start at a
+// multiple of LANES, which divides 64, so a step's bits never straddle a flush.
+// With COUNT, the row's births (next & ~self) and deaths (self & ~next) are added
+// to `counts`. They too accumulate in registers, as partial counts totaled once
+// per COUNT_BATCH steps and at the end of the row.
+template <typename VecOps, typename ScalarOps, typename RuleT, bool TRACK, bool COUNT>
+inline void swarRow(const uint64_t* a, const uint64_t* b, const uint64_t* c, uint64_t* out, const int words, const Rule& rule, uint64_t* changed, RowCounts* counts)
+{
+    using V = typename VecOps::V;
+    constexpr int L = VecOps::LANES;
+    if (words < L) {
+        swarRow<ScalarOps, ScalarOps, RuleT, TRACK, COUNT>(a, b, c, out, words, rule, changed, counts);
+        return;
+    }
+    const typename RuleT::template Eval<VecOps> vecRule(rule);
+    uint64_t bits = 0;
+    const auto record = [changed, &bits](int w, int lanes, unsigned differ) {
+        bits |= static_cast<uint64_t>(differ) << (w & 63);
+        if (((w + lanes) & 63) == 0) {
+            changed[w >> 6] |= bits;
+            bits = 0;
+        }
+    };
+    V born = VecOps::broadcast(0);
+    V died = VecOps::broadcast(0);
+    int batch = 0;
+    uint64_t births = 0;
+    uint64_t deaths = 0;
+    const auto flushCounts = [&] {
+        births += VecOps::sumCounts(born);
+        deaths += VecOps::sumCounts(died);
+        born = VecOps::broadcast(0);
+        died = VecOps::broadcast(0);
+        batch = 0;
+    };
+    const auto emit = [&](int w, V v) {
+        if constexpr (TRACK) {
+            record(w, L, VecOps::differ(v, VecOps::load(out + w)));
+        }
+        if constexpr (COUNT) {
+            const V self = VecOps::load(b + w);
+            born = VecOps::addCounts(born, VecOps::bitCounts(VecOps::andnot(self, v)));
+            died = VecOps::addCounts(died, VecOps::bitCounts(VecOps::andnot(v, self)));
+            if (++batch == COUNT_BATCH) {
+                flushCounts();
+            }
+        }
+        VecOps::store(out + w, v);
+    };
+    // Scalar words past the last full step.
+    const auto emitWord = [&](int w, uint64_t v) {
+        if constexpr (TRACK) {
+            record(w, 1, ScalarOps::differ(v, out[w]));
+        }
+        if constexpr (COUNT) {
+            births += ScalarOps::sumCounts(ScalarOps::bitCounts(v & ~b[w]));
+            deaths += ScalarOps::sumCounts(ScalarOps::bitCounts(b[w] & ~v));
+        }
+        out[w] = v;
+    };
+    const auto finish = [&] {
+        if constexpr (TRACK) {
+            changed[(words - 1) >> 6] |= bits;
+        }
+        if constexpr (COUNT) {
+            flushCounts();
+            counts->births += births;
+            counts->deaths += deaths;
+        }
+    };
+
+    // First step: nothing left of word 0.
+    {
+        const V aC = VecOps::load(a);
+        const V bC = VecOps::load(b);
+        const V cC = VecOps::load(c);
+        const bool only = words == L;
+        const V aN = only ? VecOps::edgeNext(aC) : VecOps::load(a + 1);
+        const V bN = only ? VecOps::edgeNext(bC) : VecOps::load(b + 1);
+        const V cN = only ? VecOps::edgeNext(cC) : VecOps::load(c + 1);
+        emit(0, lifeStep<VecOps>(VecOps::edgePrev(aC), aC, aN, VecOps::edgePrev(bC), bC, bN, VecOps::edgePrev(cC), cC, cN, vecRule));
+        if (only) {
+            finish();
+            return;
+        }
+    }
+
+    int w = L;
+    for (; w + L < words; w += L) {
+        emit(w, lifeStepAt<VecOps>(a, b, c, w, vecRule));
+    }
+
+    if (w + L == words) {
+        // Last step ends exactly at the row's right edge.
+        const V aC = VecOps::load(a + w);
+        const V bC = VecOps::load(b + w);
+        const V cC = VecOps::load(c + w);
+        emit(w, lifeStep<VecOps>(VecOps::load(a + w - 1), aC, VecOps::edgeNext(aC), VecOps::load(b + w - 1), bC, VecOps::edgeNext(bC), VecOps::load(c + w - 1), cC, VecOps::edgeNext(cC), vecRule));
+        finish();
+        return;
+    }
+
+    const typename RuleT::template Eval<ScalarOps> scalarRule(rule);
+    const int last = words - 1;
+    for (; w < last; ++w) {
+        emitWord(w, lifeStepAt<ScalarOps>(a, b, c, w, scalarRule));
+    }
+    emitWord(last, lifeStep<ScalarOps>(a[last - 1], a[last], 0, b[last - 1], b[last], 0, c[last - 1], c[last], 0, scalarRule));
+    finish();
+}
+
+// swarRow as a RowKernel, with the row width either baked in at compile time
+// (WORDS > 0; the `words` argument is then ignored) or read at runtime (WORDS == 0).
+// Change tracking and counting are picked once per row, so the plain loop carries
+// none of either.
+template <typename VecOps, typename ScalarOps, typename RuleT, int WORDS>
+void swarRowKernel(const uint64_t* a, const uint64_t* b, const uint64_t* c, uint64_t* out, const int words, const Rule& rule, uint64_t* changed, RowCounts* counts)
+{
+    const int n = WORDS > 0 ? WORDS : words;
+    if (counts != nullptr) {
+        if (changed != nullptr) {
+            swarRow<VecOps, ScalarOps, RuleT, true, true>(a, b, c, out, n, rule, changed, counts);
+        } else {
+            swarRow<VecOps, ScalarOps, RuleT, false, true>(a, b, c, out, n, rule, changed, counts);
+        }
+    } else if (changed != nullptr) {
+        swarRow<VecOps, ScalarOps, RuleT, true, false>(a, b, c, out, n, rule, changed, counts);
+    } else {
+        swarRow<VecOps, ScalarOps, RuleT, false, false>(a, b, c, out, n, rule, changed, counts);
+    }
+}
+
+// Kernel for rows of `words` words: a fixed-width instantiation for the common
+// power-of-two sizes (512 .. 32768 cells), the runtime-width one otherwise.
+template <typename VecOps, typename ScalarOps, typename RuleT>
+RowKernel selectWidthKernel(const int words)
+{
+    switch (words) {
+    case 8:
+        return swarRowKernel<VecOps, ScalarOps, RuleT, 8>;
+    case 16:
+        return swarRowKernel<VecOps, ScalarOps, RuleT, 16>;
+    case 32:
+        return swarRowKernel<VecOps, ScalarOps, RuleT, 32>;
+    case 64:
+        return swarRowKernel<VecOps, ScalarOps, RuleT, 64>;
+    case 128:
+        return swarRowKernel<VecOps, ScalarOps, RuleT, 128>;
+    case 256:
+        return swarRowKernel<VecOps, ScalarOps, RuleT, 256>;
+    case 512:
+        return swarRowKernel<VecOps, ScalarOps, RuleT, 512>;
+    default:
+        return swarRowKernel<VecOps, ScalarOps, RuleT, 0>;
+    }
+}
+
+template <typename Select, std::size_t... I>
+auto selectNamedRule(const Rule& rule, const Select& select, std::index_sequence<I...>)
+{
+    decltype(select.template operator()<GenericRule>()) chosen {};
+    ((chosen = (chosen == nullptr && rule == NAMED_RULES[I].rule) ? select.template operator()<StaticRule<NAMED_RULES[I].rule>>() : chosen), ...);
+    return chosen;
+}
+
+// select.template operator()<RuleT>() -- typically a kernel pointer -- for the
+// RuleT that runs `rule`: StaticRule<rule> if it is one of NAMED_RULES, else
+// the generic table-driven GenericRuleT, without the count-8 correction when
+// the rule needs none.
+template <typename Select>
+auto selectRule(const Rule& rule, const Select& select)
+{
+    constexpr std::size_t COUNT = sizeof(NAMED_RULES) / sizeof(NAMED_RULES[0]);
+    if (const auto chosen = selectNamedRule(rule, select, std::make_index_sequence<COUNT> {})) {
+        return chosen;
+    }
+    if (ruleEightFix(rule) == 0) {
+        return select.template operator()<GenericRuleT<false>>();
+    }
+    return select.template operator()<GenericRule>();
+}
+
+// Kernel for rows of `words` words under `rule`.
+template <typename VecOps, typename ScalarOps>
+RowKernel selectRowKernel(const int words, const Rule& rule)
+{
+    return selectRule(rule, [words]<typename RuleT>() { return selectWidthKernel<VecOps, ScalarOps, RuleT>(words); });
+}
+
+// Evaluate a column of `rows` one-word rows (see ColumnKernel). Here the lanes
+// run down the column: the rows above/at/below a chunk are just loads one word
+// apart in the padded west/mid/east arrays, so no lane shuffles are needed.
+template <typename VecOps, typename ScalarOps, typename RuleT>
+void swarColumn(const uint64_t* west, const uint64_t* mid, const uint64_t* east, uint64_t* out, const int rows, const Rule& rule)
+{
+    constexpr int L = VecOps::LANES;
+    const typename RuleT::template Eval<VecOps> vecRule(rule);
+    int r = 0;
+    for (; r + L <= rows; r += L) {
+        VecOps::store(out + r, lifeStep<VecOps>(
+                                   VecOps::load(west + r), VecOps::load(mid + r), VecOps::load(east + r),
+                                   VecOps::load(west + r + 1), VecOps::load(mid + r + 1), VecOps::load(east + r + 1),
+                                   VecOps::load(west + r + 2), VecOps::load(mid + r + 2), VecOps::load(east + r + 2),
+                                   vecRule));
+    }
+    if (r < rows) {
+        const typename RuleT::template Eval<ScalarOps> scalarRule(rule);
+        for (; r < rows; ++r) {
+            out[r] = lifeStep<ScalarOps>(west[r], mid[r], east[r], west[r + 1], mid[r + 1], east[r + 1], west[r + 2], mid[r + 2], east[r + 2], scalarRule);
+        }
+    }
+}
+
+template <typename VecOps, typename ScalarOps>
+ColumnKernel selectColumnKernel(const Rule& rule)
+{
+    return selectRule(rule, []<typename RuleT>() { return &swarColumn<VecOps, ScalarOps, RuleT>; });
+}
+
+// A CountKernel: the same counting as swarRow's, over words already computed.
+template <typename VecOps, typename ScalarOps>
+void swarCount(const uint64_t* before, const uint64_t* after, const int words, RowCounts& counts)
+{
+    constexpr int L = VecOps::LANES;
+    using V = typename VecOps::V;
+    int w = 0;
+    while (w + L <= words) {
+        V born = VecOps::broadcast(0);
+        V died = VecOps::broadcast(0);
+        for (int i = 0; i < COUNT_BATCH && w + L <= words; ++i, w += L) {
+            const V self = VecOps::load(before + w);
+            const V next = VecOps::load(after + w);
+            born = VecOps::addCounts(born, VecOps::bitCounts(VecOps::andnot(self, next)));
+            died = VecOps::addCounts(died, VecOps::bitCounts(VecOps::andnot(next, self)));
+        }
+        counts.births += VecOps::sumCounts(born);
+        counts.deaths += VecOps::sumCounts(died);
+    }
+    for (; w < words; ++w) {
+        counts.births += ScalarOps::sumCounts(ScalarOps::bitCounts(after[w] & ~before[w]));
+        counts.deaths += ScalarOps::sumCounts(ScalarOps::bitCounts(before[w] & ~after[w]));
+    }
+}
+
+// A HashKernel: NH over the words under two keys, each lane of a vector
+// stepping its own keys along: lane i starts i steps ahead. The tail goes
+// through ScalarOps.
+template <typename VecOps, typename ScalarOps>
+uint64_t swarHash(const uint64_t* words, const int count, const uint64_t first)
+{
+    constexpr int L = VecOps::LANES;
+    using V = typename VecOps::V;
+    const uint64_t start1 = (first + 1) * HASH_STEP1;
+    const uint64_t start2 = (first + 1) * HASH_STEP2;
+    V h1 = VecOps::broadcast(0);
+    V h2 = VecOps::broadcast(0);
+    int w = 0;
+    if (count >= L) {
+        V key1 = VecOps::add64(VecOps::broadcast(start1), VecOps::load(HASH_LANE_STEPS1));
+        V key2 = VecOps::add64(VecOps::broadcast(start2), VecOps::load(HASH_LANE_STEPS2));
+        const V step1 = VecOps::broadcast(L * HASH_STEP1);
+        const V step2 = VecOps::broadcast(L * HASH_STEP2);
+        for (; w + L <= count; w += L) {
+            const V v = VecOps::load(words + w);
+            h1 = VecOps::add64(h1, VecOps::mulHalves(VecOps::add64(v, key1)));
+            h2 = VecOps::add64(h2, VecOps::mulHalves(VecOps::add64(v, key2)));
+            key1 = VecOps::add64(key1, step1);
+            key2 = VecOps::add64(key2, step2);
+        }
+    }
+    uint64_t s1 = VecOps::sum64(h1);
+    uint64_t s2 = VecOps::sum64(h2);
+    for (; w < count; ++w) {
+        s1 += ScalarOps::mulHalves(words[w] + start1 + (static_cast<uint64_t>(w) * HASH_STEP1));
+        s2 += ScalarOps::mulHalves(words[w] + start2 + (static_cast<uint64_t>(w) * HASH_STEP2));
+    }
+    return s1 + (s2 * HASH_MIX);
+}
+
+// A NeighborKernel: neighborSum over a row, with the same edge handling as swarRow.
+template <typename VecOps, typename ScalarOps>
+void swarNeighbors(const uint64_t* a, const uint64_t* b, const uint64_t* c, uint64_t* planes, const int words)
+{
+    constexpr int L = VecOps::LANES;
+    if (words < L) {
+        swarNeighbors<ScalarOps, ScalarOps>(a, b, c, planes, words);
+        return;
+    }
+    const auto store = [planes, words]<typename Ops>(int w, const NeighborSum<Ops>& n) {
+        Ops::store(planes + w, n.s0);
+        Ops::store(planes + words + w, n.s1);
+        Ops::store(planes + (2 * words) + w, n.s2);
+        Ops::store(planes + (3 * words) + w, n.s3);
+    };
+    const auto load = [](const uint64_t* row, int w) { return VecOps::load(row + w); };
+
+    const bool only = words == L;
+    store.template operator()<VecOps>(0, neighborSum<VecOps>(
+                                             VecOps::edgePrev(load(a, 0)), load(a, 0), only ? VecOps::edgeNext(load(a, 0)) : load(a, 1),
+                                             VecOps::edgePrev(load(b, 0)), load(b, 0), only ? VecOps::edgeNext(load(b, 0)) : load(b, 1),
+                                             VecOps::edgePrev(load(c, 0)), load(c, 0), only ? VecOps::edgeNext(load(c, 0)) : load(c, 1)));
+    if (only) {
+        return;
+    }
+    int w = L;
+    for (; w + L < words; w += L) {
+        store.template operator()<VecOps>(w, neighborSum<VecOps>(
+                                                 load(a, w - 1), load(a, w), load(a, w + 1),
+                                                 load(b, w - 1), load(b, w), load(b, w + 1),
+                                                 load(c, w - 1), load(c, w), load(c, w + 1)));
+    }
+    if (w + L == words) {
+        store.template operator()<VecOps>(w, neighborSum<VecOps>(
+                                                 load(a, w - 1), load(a, w), VecOps::edgeNext(load(a, w)),
+                                                 load(b, w - 1), load(b, w), VecOps::edgeNext(load(b, w)),
+                                                 load(c, w - 1), load(c, w), VecOps::edgeNext(load(c, w))));
+        return;
+    }
+    const int last = words - 1;
+    for (; w < last; ++w) {
+        store.template operator()<ScalarOps>(w, neighborSum<ScalarOps>(a[w - 1], a[w], a[w + 1], b[w - 1], b[w], b[w + 1], c[w - 1], c[w], c[w + 1]));
+    }
+    store.template operator()<ScalarOps>(last, neighborSum<ScalarOps>(a[last - 1], a[last], 0, b[last - 1], b[last], 0, c[last - 1], c[last], 0));
+}
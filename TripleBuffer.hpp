@@ -0,0 +1,70 @@
+// Conway's Game of Life
+// Copyright (c) 2025 Faraz Fallahi <fffaraz@gmail.com>
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+// Lock-free handoff of whole generations from one writer (the simulation thread)
+// to one reader (the render thread). Of the three buffers the writer owns one
+// (back), the reader owns one (front), and the third (middle) holds the newest
+// published generation. publish() and latest() each swap their own buffer with
+// the middle one in a single atomic exchange, so neither side ever waits for the
+// other: the renderer always gets the latest complete generation (skipping any
+// it was too slow to show), and the simulator never waits on the renderer, as
+// renderGrid() paints on a render pool of its own (see forEachRenderBand).
+//
+// The writer also keeps reading the buffer it published last (current()), to
+// step the next generation from. The reader may be reading it too, but neither
+// side writes it until the writer has published another: only back is written.
+// Until the reader takes the newest generation, back holds the one before
+// current, exactly as in a ping-pong pair, so the grid's in-place stepping and
+// activity tracking keep working.
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() = default;
+
+    // Construct all three buffers from the same arguments (e.g. a runtime grid size).
+    template <typename... Args>
+    explicit TripleBuffer(const Args&... args)
+        : buffer_ { T(args...), T(args...), T(args...) }
+    {
+    }
+
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    // Writer side. The last published buffer, still readable by the writer.
+    const T& current() const { return buffer_[current_]; }
+    // The buffer the writer fills next; not visible to the reader until publish().
+    T& back() { return buffer_[back_]; }
+    // Make back the newest generation; back() is then a buffer the reader is
+    // done with.
+    void publish()
+    {
+        const uint8_t previous = middle_.exchange(static_cast<uint8_t>(back_ | FRESH), std::memory_order_acq_rel);
+        current_ = back_;
+        back_ = previous & INDEX;
+    }
+
+    // Reader side. The newest published buffer, unchanged until the next call.
+    const T& latest()
+    {
+        if ((middle_.load(std::memory_order_relaxed) & FRESH) != 0) {
+            front_ = middle_.exchange(front_, std::memory_order_acq_rel) & INDEX;
+        }
+        return buffer_[front_];
+    }
+
+private:
+    static constexpr uint8_t INDEX = 3;
+    static constexpr uint8_t FRESH = 4; // middle holds a generation the reader has not taken
+
+    T buffer_[3];
+    std::atomic<uint8_t> middle_ { 1 }; // index | FRESH
+    uint8_t front_ = 0; // reader's
+    uint8_t back_ = 2; // writer's
+    uint8_t current_ = 1; // writer's; all three start out equal
+};
@@ -0,0 +1,223 @@
+// Conway's Game of Life
+// Copyright (c) 2025 Faraz Fallahi <fffaraz@gmail.com>
+
+#include "Tuner.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// Fewer rows than this per band is all barrier and halo, never a win.
+constexpr int MIN_TUNE_ROWS_PER_BAND = 16;
+// Untimed updates before each candidate's timing, and the fewest timed ones.
+constexpr int WARMUP_UPDATES = 2;
+constexpr int MIN_TIMED_UPDATES = 3;
+
+constexpr char CACHE_HEADER[] = "# Game of Life thread tuning: cpu model | hardware threads | WxH | threads | schedule";
+
+struct Candidate {
+    int threads;
+    Schedule schedule;
+};
+
+std::vector<Candidate> candidates(const DynamicGrid& grid)
+{
+    const int hardware = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    const int maxThreads = std::max(1, std::min(hardware, grid.height() / MIN_TUNE_ROWS_PER_BAND));
+    std::vector<int> counts;
+    for (int t = 1; t < maxThreads; t *= 2) {
+        counts.push_back(t);
+    }
+    counts.push_back(maxThreads);
+    std::vector<Candidate> out;
+    for (const int t : counts) {
+        out.push_back({ t, Schedule::Auto });
+        if (t > 1) {
+            out.push_back({ t, Schedule::Stealing });
+        }
+    }
+    return out;
+}
+
+// Generations per second of grid's copies under candidate c, over about `slice`.
+double measure(const DynamicGrid& grid, const Candidate& c, std::chrono::nanoseconds slice)
+{
+    using clock = std::chrono::steady_clock;
+    DynamicGrid a = grid;
+    DynamicGrid b(grid.width(), grid.height());
+    a.setThreads(c.threads);
+    b.setThreads(c.threads);
+    a.setSchedule(c.schedule);
+    DynamicGrid* curr = &a;
+    DynamicGrid* next = &b;
+    const auto update = [&] {
+        const int k = curr->generationsPerUpdate();
+        next->updateGrid(*curr, k);
+        std::swap(curr, next);
+        return k;
+    };
+    for (int i = 0; i < WARMUP_UPDATES; ++i) {
+        update();
+    }
+    long long generations = 0;
+    const auto t0 = clock::now();
+    auto elapsed = clock::duration {};
+    for (int i = 0; i < MIN_TIMED_UPDATES || elapsed < slice; ++i) {
+        generations += update();
+        elapsed = clock::now() - t0;
+    }
+    return static_cast<double>(generations) / std::chrono::duration<double>(elapsed).count();
+}
+
+std::string trim(const std::string& s)
+{
+    const auto first = s.find_first_not_of(" \t");
+    const auto last = s.find_last_not_of(" \t\r");
+    return first == std::string::npos ? std::string() : s.substr(first, last - first + 1);
+}
+
+// A cache line's fields: the three of the key, then threads and schedule.
+std::vector<std::string> fields(const std::string& line)
+{
+    std::vector<std::string> out;
+    std::stringstream in(line);
+    std::string field;
+    while (std::getline(in, field, '|')) {
+        out.push_back(trim(field));
+    }
+    return out;
+}
+
+std::vector<std::string> cacheKey(int width, int height)
+{
+    // The model name is free text, but never holds a '|'.
+    std::string model = cpuModel();
+    std::replace(model.begin(), model.end(), '|', '/');
+    return { model, std::to_string(std::thread::hardware_concurrency()), std::to_string(width) + "x" + std::to_string(height) };
+}
+
+bool matches(const std::vector<std::string>& f, const std::vector<std::string>& key)
+{
+    return f.size() == 5 && std::equal(key.begin(), key.end(), f.begin());
+}
+
+} // namespace
+
+std::string cpuModel()
+{
+    std::ifstream in("/proc/cpuinfo");
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.rfind("model name", 0) == 0) {
+            const auto colon = line.find(':');
+            if (colon != std::string::npos) {
+                return trim(line.substr(colon + 1));
+            }
+        }
+    }
+    return "unknown";
+}
+
+std::string defaultTuneCachePath()
+{
+    constexpr char FILE_NAME[] = "gameoflife-tune.txt";
+    if (const char* cache = std::getenv("XDG_CACHE_HOME"); cache != nullptr && *cache != '\0') {
+        return (std::filesystem::path(cache) / FILE_NAME).string();
+    }
+#ifdef _WIN32
+    if (const char* local = std::getenv("LOCALAPPDATA"); local != nullptr && *local != '\0') {
+        return (std::filesystem::path(local) / FILE_NAME).string();
+    }
+#else
+    if (const char* home = std::getenv("HOME"); home != nullptr && *home != '\0') {
+        return (std::filesystem::path(home) / ".cache" / FILE_NAME).string();
+    }
+#endif
+    return {};
+}
+
+std::optional<Tuning> loadTuning(const std::string& cachePath, const int width, const int height)
+{
+    std::ifstream in(cachePath);
+    const std::vector<std::string> key = cacheKey(width, height);
+    std::string line;
+    while (std::getline(in, line)) {
+        const std::vector<std::string> f = fields(line);
+        Tuning tuning;
+        if (line.empty() || line[0] == '#' || !matches(f, key) || !parseSchedule(f[4].c_str(), tuning.schedule)) {
+            continue;
+        }
+        tuning.threads = std::atoi(f[3].c_str());
+        if (tuning.threads > 0) {
+            return tuning;
+        }
+    }
+    return std::nullopt;
+}
+
+void saveTuning(const std::string& cachePath, const int width, const int height, const Tuning& tuning)
+{
+    // Keep the other hosts' and sizes' entries.
+    const std::vector<std::string> key = cacheKey(width, height);
+    std::vector<std::string> lines;
+    {
+        std::ifstream in(cachePath);
+        std::string line;
+        while (std::getline(in, line)) {
+            if (!line.empty() && line[0] != '#' && !matches(fields(line), key)) {
+                lines.push_back(line);
+            }
+        }
+    }
+    lines.push_back(key[0] + " | " + key[1] + " | " + key[2] + " | " + std::to_string(tuning.threads) + " | " + scheduleName(tuning.schedule));
+
+    std::error_code error;
+    const std::filesystem::path parent = std::filesystem::path(cachePath).parent_path();
+    if (!parent.empty()) {
+        std::filesystem::create_directories(parent, error);
+    }
+    const std::string temporary = cachePath + ".tmp";
+    {
+        std::ofstream out(temporary);
+        out << CACHE_HEADER << "\n";
+        for (const std::string& line : lines) {
+            out << line << "\n";
+        }
+        if (!out.flush()) {
+            throw std::runtime_error(cachePath + ": cannot write");
+        }
+    }
+    std::filesystem::rename(temporary, cachePath, error);
+    if (error) {
+        throw std::runtime_error(cachePath + ": cannot replace: " + error.message());
+    }
+}
+
+Tuning calibrate(const DynamicGrid& grid, const std::chrono::milliseconds budget)
+{
+    const std::vector<Candidate> all = candidates(grid);
+    const auto slice = std::chrono::duration_cast<std::chrono::nanoseconds>(budget) / static_cast<long long>(all.size());
+    Tuning best;
+    for (const Candidate& c : all) {
+        const double rate = measure(grid, c, slice);
+        if (rate > best.generationsPerSecond) {
+            best = { c.threads, c.schedule, rate };
+        }
+    }
+    return best;
+}
+
+void applyTuning(DynamicGrid& grid, const Tuning& tuning)
+{
+    grid.setThreads(tuning.threads);
+    grid.setSchedule(tuning.schedule);
+}
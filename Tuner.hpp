@@ -0,0 +1,46 @@
+// Conway's Game of Life
+// Copyright (c) 2025 Faraz Fallahi <fffaraz@gmail.com>
+
+#pragma once
+
+#include "Grid.hpp"
+
+#include <chrono>
+#include <optional>
+#include <string>
+
+// Startup calibration of how a grid is split among update threads. Rather than
+// trusting gridThreadsForRows' fixed heuristic (or a GOL_THREADS hand-tuned per
+// host), calibrate() times a few generations of the grid itself at each
+// candidate thread count (1, 2, 4, ... up to the hardware threads, at least 16
+// rows per band) under the auto and the stealing schedule, and returns the
+// fastest for applyTuning() to set.
+// Results can be cached in a text file, one line per CPU model, hardware thread
+// count and grid size, so each host pays for calibration once per size.
+struct Tuning {
+    int threads = 1;
+    Schedule schedule = Schedule::Auto;
+    double generationsPerSecond = 0; // as measured; 0 when read from a cache
+};
+
+// "model name" of /proc/cpuinfo (Linux), else "unknown".
+std::string cpuModel();
+
+// $XDG_CACHE_HOME/gameoflife-tune.txt, else ~/.cache/gameoflife-tune.txt (or
+// %LOCALAPPDATA% on Windows); empty if none of these is set.
+std::string defaultTuneCachePath();
+
+// The cached tuning for this host and grid size, if cachePath has one. A
+// missing or unreadable file is an empty cache.
+std::optional<Tuning> loadTuning(const std::string& cachePath, int width, int height);
+// Add or replace this host's entry for the grid size. Throws
+// std::runtime_error if the file cannot be written.
+void saveTuning(const std::string& cachePath, int width, int height, const Tuning& tuning);
+
+// Time the candidates on copies of grid, spending about `budget` in all, and
+// return the fastest.
+Tuning calibrate(const DynamicGrid& grid, std::chrono::milliseconds budget);
+
+// Give grid the tuning's thread count and schedule. Set updateGrid's ping-pong
+// partner to the same thread count (the destination's pool runs the update).
+void applyTuning(DynamicGrid& grid, const Tuning& tuning);
@@ -0,0 +1,472 @@
+// Conway's Game of Life
+// Copyright (c) 2025 Faraz Fallahi <fffaraz@gmail.com>
+
+#include "Affinity.hpp"
+#include "Common.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Benchmark sweep: every combination of grid size, worker thread count, seed
+// pattern and density, each timed over several samples that start from the same
+// seed, reported as median and 10th/90th percentile generations/s and ns/cell.
+// Text for reading, JSON or CSV for tracking kernel and executor changes.
+
+namespace {
+
+enum class Pattern {
+    Soup, // random cells at the given density
+    Gliders, // gliders all heading the same way, on a lattice: pure motion
+    StillLifes, // blocks, beehives, loaves and boats on a lattice: nothing changes
+};
+
+constexpr std::array<const char*, 3> PATTERN_NAMES { "soup", "gliders", "still" };
+
+enum class Format {
+    Text,
+    Json,
+    Csv,
+};
+
+struct Options {
+    std::vector<GridSize> sizes { { 512, 512 }, { 2048, 2048 }, { 8192, 8192 } };
+    std::vector<int> threads; // default: 1, 2, 4, ... up to the hardware threads
+    std::vector<Pattern> patterns { Pattern::Soup, Pattern::Gliders, Pattern::StillLifes };
+    std::vector<double> densities { 0.25 };
+    Boundary boundary = Boundary::Torus;
+    Rule rule;
+    long long generations = 0; // per sample; 0: about CELL_BUDGET cell updates
+    int samples = 7;
+    int warmup = 16;
+    int generationsPerSync = 0; // 0: DynamicGrid::generationsPerUpdate()
+    Schedule schedule = Schedule::Auto;
+    std::vector<int> pin; // cores for the update threads; empty: GOL_PIN's, if any
+    int spinUs = -1; // barrier spin before parking; -1: barrierSpin()'s default
+    Format format = Format::Text;
+    std::string output; // file for the report; default: stdout
+    uint64_t seed = 1;
+};
+
+struct Result {
+    GridSize size;
+    int threads;
+    Pattern pattern;
+    double density;
+    long long generations;
+    std::vector<double> seconds; // per sample
+};
+
+// Cell updates per sample when --generations is not given.
+constexpr double CELL_BUDGET = 1 << 28;
+// Lattice spacing of the glider and still-life patterns, in cells: wide enough
+// that no two neighbors ever interact.
+constexpr int SPACING = 8;
+
+// Parse a comma-separated list, each item through parse.
+template <typename T, typename F>
+bool parseList(const char* text, std::vector<T>& out, F parse)
+{
+    out.clear();
+    std::stringstream in(text);
+    std::string item;
+    while (std::getline(in, item, ',')) {
+        T value;
+        if (item.empty() || !parse(item, value)) {
+            return false;
+        }
+        out.push_back(value);
+    }
+    return !out.empty();
+}
+
+void printUsage(const char* prog)
+{
+    std::cout << "Usage: " << prog << " [options]\n"
+              << "Options (lists are comma-separated; every combination is run):\n"
+              << "  -s, --sizes LIST      Grid sizes, N or WxH (default: 512,2048,8192)\n"
+              << "  -t, --threads LIST    Worker thread counts (default: 1, 2, 4, ... up to " << std::thread::hardware_concurrency() << ")\n"
+              << "  -p, --patterns LIST   soup, gliders and/or still (default: all three)\n"
+              << "  -d, --densities LIST  Live-cell share of a soup, or occupied share of the\n"
+              << "                        glider and still-life lattices (default: 0.25)\n"
+              << "  -b, --boundary MODE   Edges: dead, torus, reflect or alive (default: torus)\n"
+              << "  -r, --rule RULE       Life-like rule: B/S string or a name (default: life); only\n"
+              << "                        named rules run at Life's speed, others take a generic kernel\n"
+              << "  -i, --generations N   Generations per sample (default: about 2^28 cell updates)\n"
+              << "  -n, --samples N       Timed samples per combination (default: 7)\n"
+              << "  -w, --warmup N        Untimed generations before the samples, which all start\n"
+              << "                        from where they leave the grid (default: 16)\n"
+              << "  -k, --block-gens K    Generations per thread sync (temporal blocking; default: auto)\n"
+              << "      --schedule MODE   Rows to threads: auto, static or stealing (default: auto)\n"
+              << "      --pin CPUS        Pin the update threads to these cores, e.g. 0-7 (default: GOL_PIN)\n"
+              << "      --spin US         Microseconds idle update threads spin before sleeping (default: " << barrierSpin().count() << ")\n"
+              << "      --seed N          Seed for the random patterns (default: 1)\n"
+              << "  -f, --format FORMAT   text, json or csv (default: text)\n"
+              << "  -o, --output FILE     Write the report to FILE (default: stdout)\n"
+              << "  -h, --help            Show this help and exit\n";
+}
+
+bool parseArgs(int argc, char** argv, Options& opts)
+{
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        auto needsValue = [&](const char* name) -> const char* {
+            if (i + 1 >= argc) {
+                std::cerr << "Missing value for " << name << "\n";
+                std::exit(1);
+            }
+            return argv[++i];
+        };
+        if (arg == "-h" || arg == "--help") {
+            printUsage(argv[0]);
+            std::exit(0);
+        } else if (arg == "-s" || arg == "--sizes") {
+            if (!parseList(needsValue("--sizes"), opts.sizes, [](const std::string& s, GridSize& v) { return parseGridSize(s.c_str(), v); })) {
+                std::cerr << "sizes must be N or WxH with positive dimensions\n";
+                return false;
+            }
+        } else if (arg == "-t" || arg == "--threads") {
+            if (!parseList(needsValue("--threads"), opts.threads, [](const std::string& s, int& v) { return (v = std::atoi(s.c_str())) > 0; })) {
+                std::cerr << "thread counts must be positive\n";
+                return false;
+            }
+        } else if (arg == "-p" || arg == "--patterns") {
+            const auto pattern = [](const std::string& s, Pattern& v) {
+                const auto it = std::find(PATTERN_NAMES.begin(), PATTERN_NAMES.end(), s);
+                v = static_cast<Pattern>(it - PATTERN_NAMES.begin());
+                return it != PATTERN_NAMES.end();
+            };
+            if (!parseList(needsValue("--patterns"), opts.patterns, pattern)) {
+                std::cerr << "patterns must be soup, gliders or still\n";
+                return false;
+            }
+        } else if (arg == "-d" || arg == "--densities") {
+            const auto density = [](const std::string& s, double& v) {
+                char* end = nullptr;
+                v = std::strtod(s.c_str(), &end);
+                return *end == '\0' && v >= 0 && v <= 1;
+            };
+            if (!parseList(needsValue("--densities"), opts.densities, density)) {
+                std::cerr << "densities must be between 0 and 1\n";
+                return false;
+            }
+        } else if (arg == "-b" || arg == "--boundary") {
+            if (!parseBoundary(needsValue("--boundary"), opts.boundary)) {
+                std::cerr << "boundary must be dead, torus, reflect or alive\n";
+                return false;
+            }
+        } else if (arg == "-r" || arg == "--rule") {
+            if (!parseRule(needsValue("--rule"), opts.rule)) {
+                std::cerr << "rule must be a B/S rule string such as B36/S23 or a rule name\n";
+                return false;
+            }
+        } else if (arg == "-i" || arg == "--generations") {
+            opts.generations = std::max(0LL, std::atoll(needsValue("--generations")));
+        } else if (arg == "-n" || arg == "--samples") {
+            opts.samples = std::max(1, std::atoi(needsValue("--samples")));
+        } else if (arg == "-w" || arg == "--warmup") {
+            opts.warmup = std::max(0, std::atoi(needsValue("--warmup")));
+        } else if (arg == "-k" || arg == "--block-gens") {
+            opts.generationsPerSync = std::max(0, std::atoi(needsValue("--block-gens")));
+        } else if (arg == "--schedule") {
+            if (!parseSchedule(needsValue("--schedule"), opts.schedule)) {
+                std::cerr << "schedule must be auto, static or stealing\n";
+                return false;
+            }
+        } else if (arg == "--spin") {
+            opts.spinUs = std::max(0, std::atoi(needsValue("--spin")));
+        } else if (arg == "--pin") {
+            if (!parseCpuList(needsValue("--pin"), opts.pin)) {
+                std::cerr << "pin must be a CPU list such as 0-7 or 0,2,4\n";
+                return false;
+            }
+        } else if (arg == "--seed") {
+            opts.seed = std::strtoull(needsValue("--seed"), nullptr, 10);
+        } else if (arg == "-f" || arg == "--format") {
+            const std::string format = needsValue("--format");
+            if (format == "text") {
+                opts.format = Format::Text;
+            } else if (format == "json") {
+                opts.format = Format::Json;
+            } else if (format == "csv") {
+                opts.format = Format::Csv;
+            } else {
+                std::cerr << "format must be text, json or csv\n";
+                return false;
+            }
+        } else if (arg == "-o" || arg == "--output") {
+            opts.output = needsValue("--output");
+        } else {
+            std::cerr << "Unknown argument: " << arg << "\n";
+            printUsage(argv[0]);
+            return false;
+        }
+    }
+    if (opts.threads.empty()) {
+        const int hardware = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        for (int t = 1; t < hardware; t *= 2) {
+            opts.threads.push_back(t);
+        }
+        opts.threads.push_back(hardware);
+    }
+    return true;
+}
+
+// The still lifes, as rows of cells (at most 4x4).
+constexpr std::array<std::array<const char*, 4>, 4> STILL_LIFES { {
+    { "**", "**", "", "" }, // block
+    { ".**", "*..*", ".**", "" }, // beehive
+    { ".**", "*..*", ".*.*", "..*" }, // loaf
+    { "**", "*.*", ".*", "" }, // boat
+} };
+constexpr std::array<const char*, 3> GLIDER { ".*", "..*", "***" };
+
+// Fill grid (cleared) with pattern at density, the same cells for the same seed.
+void seedGrid(DynamicGrid& grid, Pattern pattern, double density, uint64_t seed)
+{
+    if (pattern == Pattern::Soup) {
+        grid.randomize(density, seed);
+        return;
+    }
+    std::mt19937_64 rng(seed);
+    std::bernoulli_distribution pick(density);
+    grid.clear();
+    const auto stamp = [&](int x0, int y0, const char* const* rows, int count) {
+        for (int i = 0; i < count; ++i) {
+            for (int j = 0; rows[i][j] != '\0'; ++j) {
+                if (rows[i][j] == '*') {
+                    grid.set({ x0 + i, y0 + j }, true);
+                }
+            }
+        }
+    };
+    // Sites stop SPACING cells short of the far edges, so the lattice keeps its
+    // spacing across a torus's wrap too.
+    for (int x = 0; x + SPACING <= grid.height(); x += SPACING) {
+        for (int y = 0; y + SPACING <= grid.width(); y += SPACING) {
+            if (!pick(rng)) {
+                continue;
+            }
+            if (pattern == Pattern::Gliders) {
+                stamp(x, y, GLIDER.data(), static_cast<int>(GLIDER.size()));
+            } else {
+                stamp(x, y, STILL_LIFES[rng() % STILL_LIFES.size()].data(), 4);
+            }
+        }
+    }
+}
+
+// Linear-interpolated percentile p (0..100) of sorted values.
+double percentile(const std::vector<double>& sorted, double p)
+{
+    const double rank = p / 100 * static_cast<double>(sorted.size() - 1);
+    const std::size_t lo = static_cast<std::size_t>(rank);
+    const std::size_t hi = std::min(lo + 1, sorted.size() - 1);
+    return sorted[lo] + ((rank - static_cast<double>(lo)) * (sorted[hi] - sorted[lo]));
+}
+
+struct Summary {
+    double median;
+    double p10;
+    double p90;
+};
+
+Summary summarize(std::vector<double> values)
+{
+    std::sort(values.begin(), values.end());
+    return { percentile(values, 50), percentile(values, 10), percentile(values, 90) };
+}
+
+// Generations/s and ns/cell of each sample.
+Summary gensPerSecond(const Result& r)
+{
+    std::vector<double> v;
+    for (const double s : r.seconds) {
+        v.push_back(static_cast<double>(r.generations) / s);
+    }
+    return summarize(v);
+}
+
+Summary nsPerCell(const Result& r)
+{
+    const double cells = static_cast<double>(r.size.width) * r.size.height * static_cast<double>(r.generations);
+    std::vector<double> v;
+    for (const double s : r.seconds) {
+        v.push_back(s * 1e9 / cells);
+    }
+    return summarize(v);
+}
+
+Result measure(const Options& opts, GridSize size, int threads, Pattern pattern, double density)
+{
+    using clock = std::chrono::steady_clock;
+    DynamicGrid a(size.width, size.height);
+    DynamicGrid b(size.width, size.height);
+    for (DynamicGrid* g : { &a, &b }) {
+        g->setThreads(threads);
+        g->setBoundary(opts.boundary);
+        g->setRule(opts.rule);
+        g->setSchedule(opts.schedule);
+    }
+    const double cells = static_cast<double>(size.width) * size.height;
+    Result result { size, threads, pattern, density, opts.generations, {} };
+    if (result.generations == 0) {
+        result.generations = std::clamp(static_cast<long long>(CELL_BUDGET / cells), 4LL, 10000LL);
+    }
+
+    DynamicGrid* curr = &a;
+    DynamicGrid* next = &b;
+    const auto advance = [&](long long generations) {
+        while (generations > 0) {
+            const int k = static_cast<int>(std::min<long long>(opts.generationsPerSync > 0 ? opts.generationsPerSync : curr->generationsPerUpdate(), generations));
+            next->updateGrid(*curr, k);
+            std::swap(curr, next);
+            generations -= k;
+        }
+    };
+    seedGrid(*curr, pattern, density, opts.seed);
+    advance(opts.warmup);
+    // Every sample runs the same generations from the warmed-up pair, so it
+    // times a mature pattern rather than a fresh seed's first generations.
+    // Restoring both grids keeps next holding the generation before curr, which
+    // activity tracking steps from; copying into them keeps their rows placed.
+    const DynamicGrid warmCurr = *curr;
+    const DynamicGrid warmNext = *next;
+    DynamicGrid* const first = curr;
+    DynamicGrid* const second = next;
+    for (int s = 0; s < opts.samples; ++s) {
+        *first = warmCurr;
+        *second = warmNext;
+        curr = first;
+        next = second;
+        const auto t0 = clock::now();
+        advance(result.generations);
+        result.seconds.push_back(std::chrono::duration<double>(clock::now() - t0).count());
+    }
+    return result;
+}
+
+void writeText(std::ostream& out, const Result& r)
+{
+    const Summary eps = gensPerSecond(r);
+    const Summary ns = nsPerCell(r);
+    out << r.size.width << "x" << r.size.height << "\t" << r.threads << "\t" << PATTERN_NAMES[static_cast<int>(r.pattern)] << "\t" << r.density
+        << "\t" << r.generations << "\t" << eps.median << "\t" << eps.p10 << "\t" << eps.p90 << "\t" << ns.median << "\n";
+}
+
+void writeCsv(std::ostream& out, const std::vector<Result>& results)
+{
+    out << "width,height,threads,pattern,density,generations,samples,gens_per_s_median,gens_per_s_p10,gens_per_s_p90,"
+           "ns_per_cell_median,ns_per_cell_p10,ns_per_cell_p90\n";
+    for (const Result& r : results) {
+        const Summary eps = gensPerSecond(r);
+        const Summary ns = nsPerCell(r);
+        out << r.size.width << "," << r.size.height << "," << r.threads << "," << PATTERN_NAMES[static_cast<int>(r.pattern)] << "," << r.density << ","
+            << r.generations << "," << r.seconds.size() << "," << eps.median << "," << eps.p10 << "," << eps.p90 << "," << ns.median << "," << ns.p10
+            << "," << ns.p90 << "\n";
+    }
+}
+
+void writeJson(std::ostream& out, const Options& opts, const std::vector<Result>& results)
+{
+    const auto summary = [&](const Summary& s) {
+        std::ostringstream text;
+        text.precision(out.precision());
+        text << "{ \"median\": " << s.median << ", \"p10\": " << s.p10 << ", \"p90\": " << s.p90 << " }";
+        return text.str();
+    };
+    out << "{\n"
+        << "  \"simd\": \"" << simdLevelName(activeSimdLevel()) << "\",\n"
+        << "  \"hardware_threads\": " << std::thread::hardware_concurrency() << ",\n"
+        << "  \"boundary\": \"" << boundaryName(opts.boundary) << "\",\n"
+        << "  \"rule\": \"" << ruleString(opts.rule) << "\",\n"
+        << "  \"generations_per_sync\": " << opts.generationsPerSync << ",\n"
+        << "  \"schedule\": \"" << scheduleName(opts.schedule) << "\",\n"
+        << "  \"cores\": \"" << cpuListString(workerCores()) << "\",\n"
+        << "  \"spin_us\": " << barrierSpin().count() << ",\n"
+        << "  \"seed\": " << opts.seed << ",\n"
+        << "  \"results\": [";
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        out << (i == 0 ? "\n" : ",\n")
+            << "    { \"width\": " << r.size.width << ", \"height\": " << r.size.height << ", \"threads\": " << r.threads << ", \"pattern\": \""
+            << PATTERN_NAMES[static_cast<int>(r.pattern)] << "\", \"density\": " << r.density << ", \"generations\": " << r.generations
+            << ", \"samples\": " << r.seconds.size() << ",\n"
+            << "      \"gens_per_s\": " << summary(gensPerSecond(r)) << ",\n"
+            << "      \"ns_per_cell\": " << summary(nsPerCell(r)) << " }";
+    }
+    out << "\n  ]\n}\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options opts;
+    if (!parseArgs(argc, argv, opts)) {
+        return 1;
+    }
+    if (opts.spinUs >= 0) {
+        setBarrierSpin(std::chrono::microseconds(opts.spinUs));
+    }
+    // Band 0 runs on this thread: it takes the first core, the workers the rest.
+    if (!opts.pin.empty()) {
+        setWorkerCores(opts.pin);
+    }
+    if (!workerCores().empty() && !pinCurrentThread(workerCores().front())) {
+        std::cerr << "Cannot pin threads to core " << workerCores().front() << "; running unpinned\n";
+        setWorkerCores({});
+    }
+    std::ofstream file;
+    if (!opts.output.empty()) {
+        file.open(opts.output);
+        if (!file) {
+            std::cerr << opts.output << ": cannot create\n";
+            return 1;
+        }
+    }
+    std::ostream& out = opts.output.empty() ? std::cout : file;
+    out.precision(6);
+
+    // Text rows go out as they are measured; JSON and CSV at the end, with
+    // progress on stderr meanwhile.
+    if (opts.format == Format::Text) {
+        out << "SIMD kernel: " << simdLevelName(activeSimdLevel()) << ", hardware threads: " << std::thread::hardware_concurrency()
+            << ", boundary: " << boundaryName(opts.boundary) << ", rule: " << ruleString(opts.rule) << ", schedule: " << scheduleName(opts.schedule) << ", samples: " << opts.samples << "\n"
+            << "size\tthreads\tpattern\tdensity\tgens\tgens/s (median)\tp10\tp90\tns/cell (median)\n";
+        out.flush();
+    }
+    std::vector<Result> results;
+    for (const GridSize& size : opts.sizes) {
+        for (const int threads : opts.threads) {
+            for (const Pattern pattern : opts.patterns) {
+                for (const double density : opts.densities) {
+                    if (opts.format != Format::Text) {
+                        std::cerr << size.width << "x" << size.height << " threads " << threads << " " << PATTERN_NAMES[static_cast<int>(pattern)]
+                                  << " " << density << "\n";
+                    }
+                    results.push_back(measure(opts, size, threads, pattern, density));
+                    if (opts.format == Format::Text) {
+                        writeText(out, results.back());
+                        out.flush();
+                    }
+                }
+            }
+        }
+    }
+    if (opts.format == Format::Json) {
+        writeJson(out, opts, results);
+    } else if (opts.format == Format::Csv) {
+        writeCsv(out, results);
+    }
+    return out ? 0 : 1;
+}
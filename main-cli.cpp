@@ -1,31 +1,153 @@
 // Conway's Game of Life - headless CLI benchmark
 // Copyright (c) 2025 Faraz Fallahi <fffaraz@gmail.com>
 
+#include "Affinity.hpp"
+#include "BatchLife.hpp"
+#include "Checkpoint.hpp"
 #include "Common.hpp"
+#include "CycleDetector.hpp"
+#include "HashLife.hpp"
+#include "PatternIO.hpp"
+#include "Recording.hpp"
+#include "SparseLife.hpp"
+#include "Tuner.hpp"
 
+#include <algorithm>
 #include <chrono>
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <memory>
+#include <optional>
+#include <stdexcept>
 #include <string>
+#include <vector>
 
 namespace {
 
+enum class Engine {
+    Grid, // dense bit-packed DynamicGrid, one generation per updateGrid
+    HashLife, // quadtree with memoized jumps, unbounded plane
+    Sparse, // hash map of 64x64 tiles, only active ones stepped, unbounded plane
+};
+
 struct Options {
-    int iterations = 10000;
+    GridSize size { GRID_SIZE, GRID_SIZE };
+    Boundary boundary = Boundary::Dead;
+    Rule rule;
+    bool ruleSet = false; // --rule given: it overrides a loaded pattern's rule
+    Engine engine = Engine::Grid;
+    std::size_t memoryMiB = HashLife::DEFAULT_MEMORY_BUDGET >> 20;
+    long long iterations = 10000;
     int warmup = 10;
+    int generationsPerSync = 0; // 0: DynamicGrid::generationsPerUpdate()
+    Schedule schedule = Schedule::Auto;
+    std::vector<int> pin; // cores for the update threads; empty: GOL_PIN's, if any
+    int spinUs = -1; // barrier spin before parking; -1: barrierSpin()'s default
+    bool tune = false; // calibrate threads and schedule at startup
+    bool retune = false; // calibrate even when the cache has an entry
+    std::string tuneCache = defaultTuneCachePath(); // empty: no cache
     bool addNoise = false;
-    int initialNoise = (GRID_SIZE * GRID_SIZE) / 4;
+    bool stats = false; // population, births and deaths every generation
+    bool bandStats = false; // worker pool timings of the timed generations
+    bool stopOnCycle = false; // end the timed run once the grid repeats
+    int cycleHistory = CycleDetector::DEFAULT_HISTORY; // generations looked back for a repeat
+    int initialNoise = -1; // random toggles to start from; -1: a --density soup, or nothing with --load
+    std::string load; // pattern file to seed the grid with
+    int64_t loadX = 0; // where the pattern's top-left cell goes
+    int64_t loadY = 0;
+    std::string save; // pattern file to write the final grid to
+    std::string resume; // checkpoint to continue from
+    std::string checkpoint; // checkpoint file to write
+    long long checkpointEvery = 0; // generations between checkpoints; 0: at the end only
+    std::string record; // recording of every generation to write
+    int keyframeInterval = Recorder::DEFAULT_KEYFRAME_INTERVAL;
+    std::string replay; // recording to replay instead of simulating
+    std::optional<uint64_t> seek; // generation to seek the replay to; default: the last
+    int batch = 0; // independent universes to step together instead of one grid
+    double density = 0.25; // live cell probability of the initial (or --batch) soups
+    uint64_t seed = 1; // their seed
 };
 
+std::string ruleNames()
+{
+    std::string names;
+    for (const NamedRule& named : NAMED_RULES) {
+        names += names.empty() ? "" : ", ";
+        names += named.name;
+    }
+    return names;
+}
+
+const char* engineName(Engine engine)
+{
+    switch (engine) {
+    case Engine::HashLife:
+        return "hashlife";
+    case Engine::Sparse:
+        return "sparse";
+    default:
+        return "grid";
+    }
+}
+
+// A generation count: decimal, or 2^N for big HashLife jumps.
+bool parseGenerations(const char* text, long long& generations)
+{
+    char* end = nullptr;
+    if (std::strncmp(text, "2^", 2) == 0) {
+        const long n = std::strtol(text + 2, &end, 10);
+        if (*end != '\0' || end == text + 2 || n < 0 || n > 62) {
+            return false;
+        }
+        generations = 1LL << n;
+        return true;
+    }
+    generations = std::strtoll(text, &end, 10);
+    return *end == '\0' && end != text;
+}
+
 void printUsage(const char* prog)
 {
     std::cout << "Usage: " << prog << " [options]\n"
               << "Options:\n"
-              << "  -i, --iterations N    Number of generations to simulate (default: 10000)\n"
+              << "  -s, --size N|WxH      Grid size in cells (default: " << GRID_SIZE << ")\n"
+              << "  -b, --boundary MODE   Edges: dead, torus, reflect or alive (default: dead)\n"
+              << "  -r, --rule RULE       Life-like rule: B/S string (e.g. B36/S23) or a name:\n"
+              << "                       " << ruleNames() << " (default: life)\n"
+              << "                        Named rules run at Life's speed; any other takes a\n"
+              << "                        generic kernel, about 1.5-2x slower\n"
+              << "  -e, --engine ENGINE   grid, hashlife or sparse (default: grid)\n"
+              << "  -m, --memory MiB      HashLife node cache budget (default: " << (HashLife::DEFAULT_MEMORY_BUDGET >> 20) << ")\n"
+              << "  -i, --iterations N    Number of generations to simulate, N or 2^K (default: 10000)\n"
               << "  -w, --warmup N        Warmup generations excluded from timing (default: 10)\n"
-              << "  -n, --noise N         Number of initial random cells to toggle (default: GRID_SIZE^2 / 4)\n"
+              << "  -k, --block-gens K    Generations per thread sync (temporal blocking; default: auto)\n"
+              << "      --schedule MODE   Rows to threads: auto, static or stealing (default: auto)\n"
+              << "      --pin CPUS        Pin the update threads to these cores, e.g. 0-7 (default: GOL_PIN)\n"
+              << "      --tune            Time thread counts and schedules on this grid and use the fastest\n"
+              << "      --retune          Like --tune, but ignore a cached result\n"
+              << "      --tune-cache FILE Where --tune keeps its results; \"\" for nowhere (default: " << defaultTuneCachePath() << ")\n"
+              << "      --spin US         Microseconds idle update threads spin before sleeping (default: " << barrierSpin().count() << ")\n"
+              << "  -n, --noise N         Start from N random toggles instead of a --density soup\n"
+              << "      --density D       Live cell probability of the initial soup (default: 0.25)\n"
+              << "      --seed S          Seed of the initial soup (default: 1)\n"
               << "      --add-noise       Add one random toggle per generation (matches GUI behavior)\n"
+              << "      --stats           Collect population, births and deaths every generation\n"
+              << "      --stop-on-cycle   Stop once the grid repeats itself (settled: still, periodic or empty)\n"
+              << "      --cycle-history N Generations looked back for a repeat, the longest period found (default: " << CycleDetector::DEFAULT_HISTORY << ")\n"
+              << "      --band-stats      Report per-band work and barrier wait times (GOL_BAND_STATS builds)\n"
+              << "  -l, --load FILE       Seed the grid from a pattern file (.rle, .cells or .mc)\n"
+              << "      --at X,Y          Row and column of the loaded pattern's top-left cell (default: 0,0)\n"
+              << "      --save FILE       Write the final grid to a pattern file (.rle, .cells or .mc)\n"
+              << "      --resume FILE     Continue from a checkpoint (its size, boundary and rule replace the options)\n"
+              << "      --checkpoint FILE Write a checkpoint of the final grid\n"
+              << "      --checkpoint-every N  Also write it every N generations (default: at the end only)\n"
+              << "      --record FILE     Record every generation (XOR deltas with keyframes)\n"
+              << "      --keyframe-every N  Keyframe interval of the recording (default: " << Recorder::DEFAULT_KEYFRAME_INTERVAL << ")\n"
+              << "      --replay FILE     Replay a recording instead of simulating: time a seek and a full pass\n"
+              << "      --seek G          Generation to seek the replay to, and --save (default: the last)\n"
+              << "      --batch N         Step N independent --density soups of --size together; report each one's population\n"
               << "  -h, --help            Show this help and exit\n";
 }
 
@@ -43,20 +165,157 @@ bool parseArgs(int argc, char** argv, Options& opts)
         if (arg == "-h" || arg == "--help") {
             printUsage(argv[0]);
             std::exit(0);
+        } else if (arg == "-s" || arg == "--size") {
+            if (!parseGridSize(needsValue("--size"), opts.size)) {
+                std::cerr << "size must be N or WxH with positive dimensions\n";
+                return false;
+            }
+        } else if (arg == "-b" || arg == "--boundary") {
+            if (!parseBoundary(needsValue("--boundary"), opts.boundary)) {
+                std::cerr << "boundary must be dead, torus, reflect or alive\n";
+                return false;
+            }
+        } else if (arg == "--schedule") {
+            if (!parseSchedule(needsValue("--schedule"), opts.schedule)) {
+                std::cerr << "schedule must be auto, static or stealing\n";
+                return false;
+            }
+        } else if (arg == "--tune") {
+            opts.tune = true;
+        } else if (arg == "--retune") {
+            opts.tune = true;
+            opts.retune = true;
+        } else if (arg == "--tune-cache") {
+            opts.tuneCache = needsValue("--tune-cache");
+        } else if (arg == "--spin") {
+            opts.spinUs = std::max(0, std::atoi(needsValue("--spin")));
+        } else if (arg == "--pin") {
+            if (!parseCpuList(needsValue("--pin"), opts.pin)) {
+                std::cerr << "pin must be a CPU list such as 0-7 or 0,2,4\n";
+                return false;
+            }
+        } else if (arg == "-r" || arg == "--rule") {
+            if (!parseRule(needsValue("--rule"), opts.rule)) {
+                std::cerr << "rule must be a B/S rule string such as B36/S23 or one of: " << ruleNames() << "\n";
+                return false;
+            }
+            opts.ruleSet = true;
+        } else if (arg == "-e" || arg == "--engine") {
+            const std::string engine = needsValue("--engine");
+            if (engine == "grid") {
+                opts.engine = Engine::Grid;
+            } else if (engine == "hashlife") {
+                opts.engine = Engine::HashLife;
+            } else if (engine == "sparse") {
+                opts.engine = Engine::Sparse;
+            } else {
+                std::cerr << "engine must be grid, hashlife or sparse\n";
+                return false;
+            }
+        } else if (arg == "-m" || arg == "--memory") {
+            opts.memoryMiB = static_cast<std::size_t>(std::max(1, std::atoi(needsValue("--memory"))));
         } else if (arg == "-i" || arg == "--iterations") {
-            opts.iterations = std::atoi(needsValue("--iterations"));
+            if (!parseGenerations(needsValue("--iterations"), opts.iterations)) {
+                std::cerr << "iterations must be a number or 2^K\n";
+                return false;
+            }
         } else if (arg == "-w" || arg == "--warmup") {
             opts.warmup = std::atoi(needsValue("--warmup"));
+        } else if (arg == "-k" || arg == "--block-gens") {
+            opts.generationsPerSync = std::max(0, std::atoi(needsValue("--block-gens")));
         } else if (arg == "-n" || arg == "--noise") {
             opts.initialNoise = std::atoi(needsValue("--noise"));
         } else if (arg == "--add-noise") {
             opts.addNoise = true;
+        } else if (arg == "--stats") {
+            opts.stats = true;
+        } else if (arg == "--stop-on-cycle") {
+            opts.stopOnCycle = true;
+        } else if (arg == "--cycle-history") {
+            opts.cycleHistory = std::max(1, std::atoi(needsValue("--cycle-history")));
+        } else if (arg == "--band-stats") {
+            if (!BAND_STATS_ENABLED) {
+                std::cerr << "--band-stats needs a build with GOL_BAND_STATS=ON\n";
+                return false;
+            }
+            opts.bandStats = true;
+        } else if (arg == "-l" || arg == "--load") {
+            opts.load = needsValue("--load");
+        } else if (arg == "--at") {
+            const char* const at = needsValue("--at");
+            char* end = nullptr;
+            opts.loadX = std::strtoll(at, &end, 10);
+            if (*end != ',') {
+                std::cerr << "--at must be X,Y\n";
+                return false;
+            }
+            opts.loadY = std::strtoll(end + 1, &end, 10);
+            if (*end != '\0') {
+                std::cerr << "--at must be X,Y\n";
+                return false;
+            }
+        } else if (arg == "--save") {
+            opts.save = needsValue("--save");
+        } else if (arg == "--resume") {
+            opts.resume = needsValue("--resume");
+        } else if (arg == "--checkpoint") {
+            opts.checkpoint = needsValue("--checkpoint");
+        } else if (arg == "--checkpoint-every") {
+            opts.checkpointEvery = std::max(0LL, std::atoll(needsValue("--checkpoint-every")));
+        } else if (arg == "--record") {
+            opts.record = needsValue("--record");
+        } else if (arg == "--keyframe-every") {
+            opts.keyframeInterval = std::max(1, std::atoi(needsValue("--keyframe-every")));
+        } else if (arg == "--replay") {
+            opts.replay = needsValue("--replay");
+        } else if (arg == "--seek") {
+            opts.seek = std::strtoull(needsValue("--seek"), nullptr, 10);
+        } else if (arg == "--batch") {
+            opts.batch = std::atoi(needsValue("--batch"));
+            if (opts.batch <= 0) {
+                std::cerr << "--batch must be > 0\n";
+                return false;
+            }
+        } else if (arg == "--density") {
+            opts.density = std::atof(needsValue("--density"));
+            if (opts.density < 0 || opts.density > 1) {
+                std::cerr << "--density must be between 0 and 1\n";
+                return false;
+            }
+        } else if (arg == "--seed") {
+            opts.seed = std::strtoull(needsValue("--seed"), nullptr, 10);
         } else {
             std::cerr << "Unknown argument: " << arg << "\n";
             printUsage(argv[0]);
             return false;
         }
     }
+    if (opts.initialNoise < 0 && (!opts.load.empty() || !opts.resume.empty())) {
+        opts.initialNoise = 0;
+    }
+    PatternFormat format;
+    for (const std::string* file : { &opts.load, &opts.save }) {
+        if (!file->empty() && !patternFormatForPath(*file, format)) {
+            std::cerr << *file << ": pattern files must end in .rle, .cells or .mc\n";
+            return false;
+        }
+    }
+    if (!opts.load.empty() && !opts.resume.empty()) {
+        std::cerr << "--load and --resume both seed the grid: pick one\n";
+        return false;
+    }
+    if (opts.checkpointEvery > 0 && opts.checkpoint.empty()) {
+        std::cerr << "--checkpoint-every needs --checkpoint FILE\n";
+        return false;
+    }
+    if (opts.engine != Engine::Grid && (!opts.resume.empty() || !opts.checkpoint.empty() || !opts.record.empty())) {
+        std::cerr << "checkpoints and recordings hold a grid: --resume, --checkpoint and --record need --engine grid\n";
+        return false;
+    }
+    if (!opts.replay.empty() && (!opts.load.empty() || !opts.resume.empty() || !opts.record.empty() || !opts.checkpoint.empty())) {
+        std::cerr << "--replay simulates nothing: no --load, --resume, --record or --checkpoint\n";
+        return false;
+    }
     if (opts.iterations <= 0) {
         std::cerr << "iterations must be > 0\n";
         return false;
@@ -64,18 +323,184 @@ bool parseArgs(int argc, char** argv, Options& opts)
     if (opts.warmup < 0) {
         opts.warmup = 0;
     }
+    if (opts.engine != Engine::Grid
+        && (opts.boundary != Boundary::Dead || opts.schedule != Schedule::Auto || opts.tune || opts.addNoise || opts.stats || opts.bandStats || opts.stopOnCycle)) {
+        std::cerr << engineName(opts.engine) << " runs an unbounded plane: no --boundary, --schedule, --tune, --add-noise, --stats, --band-stats or --stop-on-cycle\n";
+        return false;
+    }
+    if (opts.stopOnCycle && opts.addNoise) {
+        std::cerr << "--add-noise never lets the grid settle: no --stop-on-cycle\n";
+        return false;
+    }
+    if (opts.tune && opts.schedule != Schedule::Auto) {
+        std::cerr << "--tune picks the schedule: no --schedule\n";
+        return false;
+    }
+    if (opts.batch > 0
+        && (opts.engine != Engine::Grid || !opts.load.empty() || !opts.save.empty() || !opts.resume.empty() || !opts.checkpoint.empty() || !opts.record.empty()
+            || !opts.replay.empty() || opts.tune || opts.addNoise || opts.stats || opts.bandStats || opts.stopOnCycle)) {
+        std::cerr << "--batch runs random soups only: no --engine, --load, --save, --resume, --checkpoint, --record, --replay, --tune, --add-noise, --stats, "
+                     "--band-stats or --stop-on-cycle\n";
+        return false;
+    }
     return true;
 }
 
-int countAlive(const Grid<GRID_SIZE>& g)
+// Write the final grid if --save asked for it.
+int savePatternFile(const Options& opts, const DynamicGrid& grid)
+{
+    if (opts.save.empty()) {
+        return 0;
+    }
+    try {
+        savePattern(opts.save, grid);
+    } catch (const std::runtime_error& e) {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+    std::cout << "  Saved:          " << opts.save << "\n";
+    return 0;
+}
+
+// Import the seeded grid into HashLife and jump `iterations` generations at once.
+int runHashLife(const Options& opts, const DynamicGrid& seed)
+{
+    using clock = std::chrono::steady_clock;
+    HashLife life(opts.rule, opts.memoryMiB << 20);
+    life.fromGrid(seed);
+
+    const auto t0 = clock::now();
+    try {
+        life.step(static_cast<uint64_t>(opts.iterations));
+    } catch (const std::length_error& e) {
+        std::cerr << "hashlife: " << e.what() << " (try a larger --memory)\n";
+        return 1;
+    }
+    const auto t1 = clock::now();
+
+    const double seconds = std::chrono::duration<double>(t1 - t0).count();
+    DynamicGrid window(seed.width(), seed.height());
+    window.setRule(opts.rule);
+    life.toGrid(window);
+
+    std::cout << "\nResults\n"
+              << "  Elapsed:        " << seconds << " s\n"
+              << "  Generations/s:  " << static_cast<double>(opts.iterations) / seconds << "\n"
+              << "  Generation:     " << life.generation() << "\n"
+              << "  Population:     " << life.population() << " (" << window.population() << " inside the grid)\n"
+              << "  Nodes:          " << life.nodeCount() << " (" << (life.memoryUsage() >> 20) << " / " << opts.memoryMiB << " MiB, "
+              << life.collections() << " collections)\n";
+    return savePatternFile(opts, window);
+}
+
+// Import the seeded grid into the tiled engine and step it generation by generation.
+int runSparse(const Options& opts, const DynamicGrid& seed)
 {
-    int alive = 0;
-    for (int x = 0; x < GRID_SIZE; ++x) {
-        for (int y = 0; y < GRID_SIZE; ++y) {
-            alive += g.get({ x, y }) ? 1 : 0;
+    using clock = std::chrono::steady_clock;
+    SparseLife life(opts.rule);
+    life.fromGrid(seed);
+    life.step(static_cast<uint64_t>(opts.warmup));
+
+    const auto t0 = clock::now();
+    life.step(static_cast<uint64_t>(opts.iterations));
+    const auto t1 = clock::now();
+
+    const double seconds = std::chrono::duration<double>(t1 - t0).count();
+    std::cout << "\nResults\n"
+              << "  Elapsed:        " << seconds << " s\n"
+              << "  Generations/s:  " << static_cast<double>(opts.iterations) / seconds << "\n"
+              << "  Population:     " << life.population() << "\n"
+              << "  Tiles:          " << life.tileCount() << " (" << life.steppedTiles() << " stepped in the last generation)\n";
+    if (opts.save.empty()) {
+        return 0;
+    }
+    DynamicGrid window(seed.width(), seed.height());
+    window.setRule(opts.rule);
+    life.toGrid(window);
+    return savePatternFile(opts, window);
+}
+
+// Seek a recording to --seek (or its last generation), then replay it from the
+// first generation to the last.
+int runReplay(const Options& opts)
+{
+    using clock = std::chrono::steady_clock;
+    try {
+        Replayer replayer(opts.replay);
+        const uint64_t first = replayer.firstGeneration();
+        const uint64_t last = replayer.lastGeneration();
+        std::cout << "Mode: replay\n"
+                  << "Recording: " << opts.replay << " (" << replayer.width() << "x" << replayer.height() << ", generations " << first << " to "
+                  << last << ", " << replayer.keyframes() << " keyframes)\n"
+                  << "Boundary: " << boundaryName(replayer.boundary()) << "\n"
+                  << "Rule: " << ruleString(replayer.rule()) << "\n";
+        std::cout.flush();
+
+        DynamicGrid grid(replayer.width(), replayer.height());
+        const uint64_t target = opts.seek.value_or(last);
+        auto t0 = clock::now();
+        replayer.seek(target, grid);
+        const double seekSeconds = std::chrono::duration<double>(clock::now() - t0).count();
+        const long long alive = grid.population();
+
+        DynamicGrid scratch(replayer.width(), replayer.height());
+        t0 = clock::now();
+        for (uint64_t g = first; g <= last; ++g) {
+            replayer.seek(g, scratch);
         }
+        const double seconds = std::chrono::duration<double>(clock::now() - t0).count();
+
+        std::cout << "\nResults\n"
+                  << "  Seek:           generation " << target << " in " << seekSeconds * 1e3 << " ms (" << alive << " alive)\n"
+                  << "  Full replay:    " << seconds << " s\n"
+                  << "  Generations/s:  " << static_cast<double>(last - first + 1) / seconds << "\n";
+        return savePatternFile(opts, grid);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+}
+
+// Step --batch soups together and report every universe's population before
+// and after, as tab-separated lines after the summary.
+int runBatch(const Options& opts)
+{
+    using clock = std::chrono::steady_clock;
+    BatchLife batch(opts.size.width, opts.size.height, opts.batch);
+    batch.setBoundary(opts.boundary);
+    batch.setRule(opts.rule);
+    batch.randomize(opts.density, opts.seed);
+    const std::vector<long long> before = batch.populations();
+
+    printAppInfo(opts.size);
+    std::cout << "Mode: batch\n"
+              << "Universes: " << opts.batch << " (" << opts.size.width << "x" << opts.size.height << ", density " << opts.density << ", seed " << opts.seed << ")\n"
+              << "Boundary: " << boundaryName(opts.boundary) << "\n"
+              << "Rule: " << ruleString(opts.rule) << "\n"
+              << "Iterations: " << opts.iterations << "\n"
+              << "Threads: " << batch.threads() << "\n";
+    std::cout.flush();
+
+    const auto t0 = clock::now();
+    for (long long left = opts.iterations; left > 0;) {
+        const int k = static_cast<int>(std::min<long long>(left, 1 << 30));
+        batch.step(k);
+        left -= k;
+    }
+    const double seconds = std::chrono::duration<double>(clock::now() - t0).count();
+    const std::vector<long long> after = batch.populations();
+
+    const double eps = static_cast<double>(opts.iterations) / seconds;
+    const double cups = eps * opts.batch * static_cast<double>(opts.size.width) * opts.size.height;
+    std::cout << "\nResults\n"
+              << "  Elapsed:        " << seconds << " s\n"
+              << "  Generations/s:  " << eps << " (" << eps * opts.batch << " universe-generations/s)\n"
+              << "  Cells updated/s:" << cups << " (" << cups / 1e9 << " GCUpS)\n"
+              << "\nuniverse\tinitial\tfinal\n";
+    for (int u = 0; u < opts.batch; ++u) {
+        std::cout << u << "\t" << before[u] << "\t" << after[u] << "\n";
     }
-    return alive;
+    return 0;
 }
 
 } // namespace
@@ -86,57 +511,281 @@ int main(int argc, char** argv)
     if (!parseArgs(argc, argv, opts)) {
         return 1;
     }
+    if (!opts.replay.empty()) {
+        return runReplay(opts);
+    }
 
-    printAppInfo();
-    std::cout << "Mode: headless benchmark\n"
-              << "Iterations: " << opts.iterations << " (warmup: " << opts.warmup << ")\n"
-              << "Initial noise toggles: " << opts.initialNoise << "\n"
-              << "Per-step noise: " << (opts.addNoise ? "on" : "off") << "\n";
-    std::cout.flush();
+    CheckpointInfo resumed;
+    if (!opts.resume.empty()) {
+        try {
+            resumed = readCheckpointInfo(opts.resume);
+        } catch (const std::runtime_error& e) {
+            std::cerr << e.what() << "\n";
+            return 1;
+        }
+        opts.size = { resumed.width, resumed.height };
+        opts.boundary = resumed.boundary;
+        opts.rule = resumed.rule;
+    }
+
+    if (opts.spinUs >= 0) {
+        setBarrierSpin(std::chrono::microseconds(opts.spinUs));
+    }
+    // Band 0 runs on this thread: it takes the first core, the workers the rest.
+    if (!opts.pin.empty()) {
+        setWorkerCores(opts.pin);
+    }
+    if (!workerCores().empty() && !pinCurrentThread(workerCores().front())) {
+        std::cerr << "Cannot pin threads to core " << workerCores().front() << "; running unpinned\n";
+        setWorkerCores({});
+    }
+    if (opts.batch > 0) {
+        return runBatch(opts);
+    }
 
-    // Ping-pong between two raw grids — no DoubleBuffer locking overhead for the benchmark.
-    // Heap-allocated: at large GRID_SIZE two grids would overflow the stack.
-    auto a = std::make_unique<Grid<GRID_SIZE>>();
-    auto b = std::make_unique<Grid<GRID_SIZE>>();
+    // Ping-pong between two raw grids — no TripleBuffer handoff for the benchmark.
+    auto a = std::make_unique<DynamicGrid>(opts.size.width, opts.size.height);
+    auto b = std::make_unique<DynamicGrid>(opts.size.width, opts.size.height);
     a->clear();
     b->clear();
-    a->addNoise(opts.initialNoise);
+    double restoreSeconds = 0;
+    if (!opts.resume.empty()) {
+        const auto t0 = std::chrono::steady_clock::now();
+        try {
+            loadCheckpoint(opts.resume, *a);
+        } catch (const std::runtime_error& e) {
+            std::cerr << e.what() << "\n";
+            return 1;
+        }
+        restoreSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    }
+    PatternInfo pattern;
+    if (!opts.load.empty()) {
+        try {
+            pattern = loadPattern(opts.load, *a, opts.loadX, opts.loadY);
+        } catch (const std::runtime_error& e) {
+            std::cerr << e.what() << "\n";
+            return 1;
+        }
+        if (pattern.rule && !opts.ruleSet) {
+            opts.rule = *pattern.rule;
+        }
+    }
+    if (opts.engine != Engine::Grid && (opts.rule.birth & 1) != 0) {
+        std::cerr << engineName(opts.engine) << " cannot run B0 rules\n";
+        return 1;
+    }
 
-    Grid<GRID_SIZE>* curr = a.get();
-    Grid<GRID_SIZE>* next = b.get();
+    printAppInfo(opts.size);
+    std::cout << "Mode: headless benchmark\n"
+              << "Engine: " << engineName(opts.engine) << "\n"
+              << "Boundary: " << boundaryName(opts.boundary) << "\n"
+              << "Rule: " << ruleString(opts.rule);
+    if (const char* name = ruleName(opts.rule)) {
+        std::cout << " (" << name << ")";
+    }
+    std::cout << "\n"
+              << "Iterations: " << opts.iterations << " (warmup: " << opts.warmup << ")\n";
+    if (opts.initialNoise < 0) {
+        std::cout << "Initial soup: density " << opts.density << ", seed " << opts.seed << "\n";
+    } else {
+        std::cout << "Initial noise toggles: " << opts.initialNoise << "\n";
+    }
+    std::cout << "Per-step noise: " << (opts.addNoise ? "on" : "off") << "\n"
+              << "Stats: " << (opts.stats ? "every generation" : "off") << "\n";
+    if (opts.stopOnCycle) {
+        std::cout << "Stop on cycle: periods up to " << opts.cycleHistory << "\n";
+    }
+    if (opts.engine == Engine::Grid) {
+        std::cout << "Schedule: " << scheduleName(opts.schedule) << "\n";
+    }
+    if (!opts.load.empty()) {
+        std::cout << "Pattern: " << opts.load << " (" << pattern.width << "x" << pattern.height << " at " << opts.loadX << "," << opts.loadY
+                  << ", " << a->population() << " cells in the grid)\n";
+    }
+    if (!opts.resume.empty()) {
+        std::cout << "Resumed: " << opts.resume << " (generation " << resumed.generation << ", restored in " << restoreSeconds * 1e3 << " ms)\n";
+    }
+    std::cout.flush();
 
-    using clock = std::chrono::steady_clock;
+    a->setBoundary(opts.boundary);
+    b->setBoundary(opts.boundary);
+    a->setRule(opts.rule);
+    b->setRule(opts.rule);
+    a->setCollectStats(opts.stats);
+    a->setHashGenerations(opts.stopOnCycle);
+    a->setSchedule(opts.schedule);
+    if (opts.initialNoise < 0) {
+        a->randomize(opts.density, opts.seed);
+    } else {
+        a->addNoise(opts.initialNoise);
+    }
+
+    if (opts.engine == Engine::HashLife) {
+        return runHashLife(opts, *a);
+    }
+    if (opts.engine == Engine::Sparse) {
+        return runSparse(opts, *a);
+    }
 
-    for (int i = 0; i < opts.warmup; ++i) {
-        next->updateGrid(*curr);
-        if (opts.addNoise) {
-            next->addNoise();
+    if (opts.tune) {
+        // Calibrated on the grid as it will start.
+        constexpr std::chrono::milliseconds TUNE_BUDGET { 1000 };
+        std::optional<Tuning> tuning;
+        if (!opts.retune && !opts.tuneCache.empty()) {
+            tuning = loadTuning(opts.tuneCache, a->width(), a->height());
         }
-        std::swap(curr, next);
+        if (tuning) {
+            std::cout << "Tuned: " << tuning->threads << " threads, " << scheduleName(tuning->schedule) << " schedule (cached in " << opts.tuneCache << ")\n";
+        } else {
+            tuning = calibrate(*a, TUNE_BUDGET);
+            std::cout << "Tuned: " << tuning->threads << " threads, " << scheduleName(tuning->schedule) << " schedule (" << tuning->generationsPerSecond
+                      << " generations/s)\n";
+            if (!opts.tuneCache.empty()) {
+                try {
+                    saveTuning(opts.tuneCache, a->width(), a->height(), *tuning);
+                } catch (const std::runtime_error& e) {
+                    std::cerr << e.what() << " (tuning not cached)\n";
+                }
+            }
+        }
+        applyTuning(*a, *tuning);
+        applyTuning(*b, *tuning);
     }
 
-    const auto t0 = clock::now();
-    for (int i = 0; i < opts.iterations; ++i) {
-        next->updateGrid(*curr);
-        if (opts.addNoise) {
-            next->addNoise();
+    DynamicGrid* curr = a.get();
+    DynamicGrid* next = b.get();
+
+    // Per-step noise, stats, cycle detection and recording need every
+    // generation materialized, so they disable blocking.
+    const int perSync = opts.addNoise || opts.stats || opts.stopOnCycle || !opts.record.empty() ? 1 : opts.generationsPerSync;
+    std::cout << "Generations per sync: ";
+    if (perSync > 0) {
+        std::cout << perSync << "\n";
+    } else {
+        std::cout << "auto (" << curr->generationsPerUpdate() << " at start)\n";
+    }
+
+    using clock = std::chrono::steady_clock;
+
+    long long births = 0;
+    long long deaths = 0;
+    uint64_t generation = resumed.generation;
+    std::optional<Recorder> recorder;
+    if (!opts.record.empty()) {
+        try {
+            recorder.emplace(opts.record, *curr, generation, opts.keyframeInterval);
+        } catch (const std::runtime_error& e) {
+            std::cerr << e.what() << "\n";
+            return 1;
         }
-        std::swap(curr, next);
     }
+    const auto checkpoint = [&] {
+        try {
+            saveCheckpoint(opts.checkpoint, *curr, generation);
+        } catch (const std::runtime_error& e) {
+            std::cerr << e.what() << "\n";
+            std::exit(1);
+        }
+    };
+    // Set while the timed run watches for a cycle, and once it finds one.
+    std::optional<CycleDetector> cycles;
+    std::optional<uint64_t> period;
+    const auto advance = [&](long long generations) {
+        while (generations > 0 && !period) {
+            long long k = std::min<long long>(perSync > 0 ? perSync : curr->generationsPerUpdate(), generations);
+            if (opts.checkpointEvery > 0) {
+                // Stop on the checkpoint generations.
+                k = std::min<long long>(k, opts.checkpointEvery - static_cast<long long>(generation % opts.checkpointEvery));
+            }
+            next->updateGrid(*curr, static_cast<int>(k));
+            if (const std::optional<GenerationStats> stats = next->stats()) {
+                births += stats->births;
+                deaths += stats->deaths;
+            }
+            if (opts.addNoise) {
+                next->addNoise();
+            }
+            std::swap(curr, next);
+            generations -= k;
+            generation += k;
+            if (recorder) {
+                try {
+                    recorder->record(*curr);
+                } catch (const std::runtime_error& e) {
+                    std::cerr << e.what() << "\n";
+                    std::exit(1);
+                }
+            }
+            if (opts.checkpointEvery > 0 && generation % opts.checkpointEvery == 0) {
+                checkpoint();
+            }
+            if (cycles) {
+                period = cycles->add(generation, curr->contentHash());
+            }
+        }
+    };
+
+    advance(opts.warmup);
+    births = 0;
+    deaths = 0;
+    curr->resetBandStats();
+    if (opts.stopOnCycle) {
+        cycles.emplace(opts.cycleHistory);
+        cycles->add(generation, curr->contentHash());
+    }
+
+    const uint64_t timedFrom = generation;
+    const auto t0 = clock::now();
+    advance(opts.iterations);
     const auto t1 = clock::now();
 
+    // All the iterations, unless a cycle cut the run short.
+    const auto ran = static_cast<long long>(generation - timedFrom);
     const double seconds = std::chrono::duration<double>(t1 - t0).count();
-    const double eps = opts.iterations / seconds;
-    const double cellsPerIter = static_cast<double>(GRID_SIZE) * GRID_SIZE;
+    const double eps = static_cast<double>(ran) / seconds;
+    const double cellsPerIter = static_cast<double>(opts.size.width) * opts.size.height;
     const double cups = eps * cellsPerIter;
-    const int finalAlive = countAlive(*curr);
+    const long long finalAlive = curr->population();
 
     std::cout << "\nResults\n"
               << "  Elapsed:        " << seconds << " s\n"
               << "  Generations/s:  " << eps << "\n"
               << "  Cells updated/s:" << cups << " (" << cups / 1e9 << " GCUpS)\n"
-              << "  ns / cell:      " << (seconds * 1e9) / (opts.iterations * cellsPerIter) << "\n"
+              << "  ns / cell:      " << (seconds * 1e9) / (static_cast<double>(ran) * cellsPerIter) << "\n"
               << "  Final alive:    " << finalAlive << " / " << static_cast<long long>(cellsPerIter) << "\n";
+    if (period) {
+        // The detector first saw generation timedFrom: a cycle through it may
+        // have started anywhere in the warmup.
+        const uint64_t settled = generation - *period;
+        const char* const when = settled == timedFrom && timedFrom > 0 ? "at or before generation " : "generation ";
+        const char* const kind = finalAlive == 0 ? "died out" : (*period == 1 ? "still life" : "oscillating");
+        std::cout << "  Settled:        " << when << settled << ", period " << *period << " (" << kind << "); stopped at generation " << generation
+                  << "\n";
+    } else if (cycles) {
+        std::cout << "  Settled:        no repeat within " << cycles->history() << " generations\n";
+    }
+    if (opts.stats) {
+        std::cout << "  Births/deaths:  " << births << " / " << deaths << " (timed generations)\n";
+    }
+    if (opts.bandStats) {
+        std::cout << "  Band timings:\n"
+                  << formatBandStats(curr->bandStats());
+    }
 
-    return 0;
+    if (recorder) {
+        try {
+            recorder->finish();
+        } catch (const std::runtime_error& e) {
+            std::cerr << e.what() << "\n";
+            return 1;
+        }
+        std::cout << "  Recording:      " << opts.record << " (generations " << resumed.generation << " to " << generation << ", "
+                  << recorder->bytes() << " bytes)\n";
+    }
+    if (!opts.checkpoint.empty()) {
+        checkpoint();
+        std::cout << "  Checkpoint:     " << opts.checkpoint << " (generation " << generation << ")\n";
+    }
+    return savePatternFile(opts, *curr);
 }
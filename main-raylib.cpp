@@ -2,6 +2,7 @@
 // Copyright (c) 2025 Faraz Fallahi <fffaraz@gmail.com>
 
 #include "Common.hpp"
+#include "Render.hpp"
 
 #include <raylib.h>
 
@@ -25,6 +26,16 @@ static constexpr std::array<Color, 9> colorMap {
     Color { 255, 255, 255, 255 }, // WHITE    - 8 live neighbors
 };
 
+// colorMap as texture pixels; raylib's Color is RGBA bytes.
+static constexpr Palette palette = [] {
+    const auto pixel = [](Color c) { return rgbaPixel(c.r, c.g, c.b, c.a); };
+    Palette p { pixel(BLACK), {} };
+    for (std::size_t n = 0; n < colorMap.size(); ++n) {
+        p.live[n] = pixel(colorMap[n]);
+    }
+    return p;
+}();
+
 std::atomic_bool mouseRightPressed = false;
 std::atomic_bool mouseLeftPressed = false;
 std::atomic_int mouseX = 0;
@@ -32,30 +43,27 @@ std::atomic_int mouseY = 0;
 
 static void updateGrid(GridType& grid)
 {
-    auto [nextGrid, writeLock] = grid.writeBuffer();
+    DynamicGrid& nextGrid = grid.back();
 
     if (mouseRightPressed.load()) {
         nextGrid.clear();
-        grid.swap(std::move(writeLock));
+        grid.publish();
         return;
     }
 
-    {
-        const auto [currGrid, readLock] = grid.readBuffer();
-        nextGrid.updateGrid(currGrid);
-    }
+    nextGrid.updateGrid(grid.current());
 
     nextGrid.addNoise();
 
     if (mouseLeftPressed.load()) {
-        const int x = mouseX.load() / CELL_SIZE;
-        const int y = mouseY.load() / CELL_SIZE;
-        if (x >= 0 && x < GRID_SIZE && y >= 0 && y < GRID_SIZE) {
-            nextGrid.toggleBlock({ x, y });
+        const int row = mouseY.load() / CELL_SIZE;
+        const int col = mouseX.load() / CELL_SIZE;
+        if (row >= 0 && row < nextGrid.height() && col >= 0 && col < nextGrid.width()) {
+            nextGrid.toggleBlock({ row, col });
         }
     }
 
-    grid.swap(std::move(writeLock));
+    grid.publish();
 }
 
 static void DrawTextOutlined(const char* text, int x, int y, int fontSize, Color color, Color outline)
@@ -67,26 +75,27 @@ static void DrawTextOutlined(const char* text, int x, int y, int fontSize, Color
     DrawText(text, x, y, fontSize, color);
 }
 
-int main()
+int main(int argc, char** argv)
 {
-    printAppInfo();
+    const GridSize gridSize = gridSizeFromArgs(argc, argv);
+    const int gridWidth = gridSize.width;
+    const int gridHeight = gridSize.height;
+    printAppInfo(gridSize);
 
-    InitWindow(GRID_SIZE * CELL_SIZE, GRID_SIZE * CELL_SIZE, "Conway's Game of Life");
+    InitWindow(gridWidth * CELL_SIZE, gridHeight * CELL_SIZE, "Conway's Game of Life");
 
     if (targetFPS > 0) {
         SetTargetFPS(targetFPS);
     }
 
-    // Heap-allocated: a GridType holds two grids inline (~8 MB at GRID_SIZE 2048),
-    // which overflows the stack if placed as a local.
-    auto gridPtr = std::make_unique<GridType>();
+    auto gridPtr = std::make_unique<GridType>(gridWidth, gridHeight);
     GridType& grid = *gridPtr;
 
     // One GPU texture holds the whole grid at 1 pixel/cell. Each frame we rewrite
     // its CPU-side pixel buffer, upload it once, and let the GPU scale it up by
-    // CELL_SIZE -- replacing up to GRID_SIZE^2 per-cell DrawPixel calls with a
+    // CELL_SIZE -- replacing up to width*height per-cell DrawPixel calls with a
     // single upload and a single draw. gridImage.data doubles as our pixel buffer.
-    Image gridImage = GenImageColor(GRID_SIZE, GRID_SIZE, BLACK);
+    Image gridImage = GenImageColor(gridWidth, gridHeight, BLACK);
     Texture2D gridTexture = LoadTextureFromImage(gridImage);
     Color* const pixels = static_cast<Color*>(gridImage.data);
 
@@ -107,6 +116,10 @@ int main()
         }
     });
 
+    // Worker pool timings, in GOL_BAND_STATS builds, refreshed every second.
+    std::string bandsStr;
+    auto bandsStart = std::chrono::steady_clock::now();
+
     while (!WindowShouldClose()) {
         mouseLeftPressed.store(IsMouseButtonDown(MOUSE_BUTTON_LEFT));
         mouseRightPressed.store(IsMouseButtonPressed(MOUSE_BUTTON_RIGHT));
@@ -117,22 +130,12 @@ int main()
         BeginDrawing();
         ClearBackground(BLACK);
 
-        int aliveCount = 0;
+        long long aliveCount = 0;
         {
-            const auto [currGrid, lock] = grid.readBuffer();
-            // Texture row j is screen row y=j; column i is screen x=i.
-            for (int j = 0; j < GRID_SIZE; ++j) {
-                Color* const row = &pixels[j * GRID_SIZE];
-                for (int i = 0; i < GRID_SIZE; ++i) {
-                    const Point p { i, j };
-                    if (currGrid.get(p)) {
-                        aliveCount++;
-                        row[i] = colorMap[currGrid.countLiveNeighbors(p)];
-                    } else {
-                        row[i] = BLACK;
-                    }
-                }
-            }
+            const DynamicGrid& currGrid = grid.latest();
+            aliveCount = currGrid.population();
+            // Texture row j is screen row y=j and grid row j; column i is screen x=i.
+            renderGrid(currGrid, palette, reinterpret_cast<std::uint32_t*>(pixels), static_cast<std::size_t>(gridWidth));
         }
         UpdateTexture(gridTexture, pixels);
         DrawTextureEx(gridTexture, { 0.0f, 0.0f }, 0.0f, static_cast<float>(CELL_SIZE), WHITE);
@@ -142,11 +145,22 @@ int main()
 
         const float fps = static_cast<float>(GetFPS());
         const float eps = epochsPerSecond.load();
-        const float cups = eps * (GRID_SIZE * GRID_SIZE / 1'000'000'000.0f);
+        const float cups = eps * (static_cast<float>(gridWidth) * gridHeight / 1'000'000'000.0f);
         char buffer[64];
         snprintf(buffer, sizeof(buffer), "FPS: %.2f\nEPS: %.2f\nCUpS: %.3fe9", fps, eps, cups);
         DrawTextOutlined(buffer, GetScreenWidth() - 200, 5, 24, WHITE, BLACK);
 
+        if constexpr (BAND_STATS_ENABLED) {
+            const auto now = std::chrono::steady_clock::now();
+            if (now - bandsStart >= std::chrono::seconds(1)) {
+                const DynamicGrid& currGrid = grid.latest();
+                bandsStr = bandStatsSummary(currGrid.bandStats());
+                currGrid.resetBandStats();
+                bandsStart = now;
+            }
+            DrawTextOutlined(bandsStr.c_str(), 10, GetScreenHeight() - 30, 18, WHITE, BLACK);
+        }
+
         EndDrawing();
     }
 
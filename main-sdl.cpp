@@ -2,19 +2,29 @@
 // Copyright (c) 2025 Faraz Fallahi <fffaraz@gmail.com>
 
 #include "Common.hpp"
+#include "Render.hpp"
 
 #include <SDL3/SDL.h>
 #include <SDL3/SDL_main.h>
 
+#include <memory>
+
 /* We will use this renderer to draw into this window every frame. */
 static SDL_Window* window = NULL;
 static SDL_Renderer* renderer = NULL;
 static SDL_Texture* texture = NULL;
+static GridSize gridSize { GRID_SIZE, GRID_SIZE };
+static std::unique_ptr<GridType> grid;
+
+/* White = alive, black = dead, as ARGB8888 pixels. */
+static constexpr Palette palette { 0xFF000000u, { 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu } };
 
 /* This function runs once at startup. */
 SDL_AppResult SDL_AppInit(void** appstate, int argc, char* argv[])
 {
-    printAppInfo();
+    gridSize = gridSizeFromArgs(argc, argv);
+    printAppInfo(gridSize);
+    grid = std::make_unique<GridType>(gridSize.width, gridSize.height);
     SDL_SetAppMetadata("Conway's Game of Life", "1.0", "com.example.gameoflife");
 
     if (!SDL_Init(SDL_INIT_VIDEO)) {
@@ -22,15 +32,15 @@ SDL_AppResult SDL_AppInit(void** appstate, int argc, char* argv[])
         return SDL_APP_FAILURE;
     }
 
-    if (!SDL_CreateWindowAndRenderer("Conway's Game of Life", GRID_SIZE * CELL_SIZE, GRID_SIZE * CELL_SIZE, SDL_WINDOW_RESIZABLE, &window, &renderer)) {
+    if (!SDL_CreateWindowAndRenderer("Conway's Game of Life", gridSize.width * CELL_SIZE, gridSize.height * CELL_SIZE, SDL_WINDOW_RESIZABLE, &window, &renderer)) {
         SDL_Log("Couldn't create window/renderer: %s", SDL_GetError());
         return SDL_APP_FAILURE;
     }
-    SDL_SetRenderLogicalPresentation(renderer, GRID_SIZE * CELL_SIZE, GRID_SIZE * CELL_SIZE, SDL_LOGICAL_PRESENTATION_LETTERBOX);
+    SDL_SetRenderLogicalPresentation(renderer, gridSize.width * CELL_SIZE, gridSize.height * CELL_SIZE, SDL_LOGICAL_PRESENTATION_LETTERBOX);
 
     /* Streaming texture holds the grid at 1 pixel/cell, scaled to fill the window
        each frame. Replaces per-cell SDL_RenderPoint calls with one upload + blit. */
-    texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, GRID_SIZE, GRID_SIZE);
+    texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, gridSize.width, gridSize.height);
     if (!texture) {
         SDL_Log("Couldn't create grid texture: %s", SDL_GetError());
         return SDL_APP_FAILURE;
@@ -55,40 +65,32 @@ static void SimStep(GridType& grid)
     float ypos = 0;
     const SDL_MouseButtonFlags btn = SDL_GetMouseState(&xpos, &ypos);
 
-    auto [nextGrid, writeLock] = grid.writeBuffer();
+    DynamicGrid& nextGrid = grid.back();
     if (btn & SDL_BUTTON_RMASK) {
         nextGrid.clear();
-        grid.swap(std::move(writeLock));
+        grid.publish();
         return;
     }
-    {
-        const auto [currGrid, readLock] = grid.readBuffer();
-        nextGrid.updateGrid(currGrid);
-    }
+    nextGrid.updateGrid(grid.current());
     nextGrid.addNoise();
     if (btn & SDL_BUTTON_LMASK) {
-        nextGrid.toggleBlock({ static_cast<int>(xpos), static_cast<int>(ypos) });
+        nextGrid.toggleBlock({ static_cast<int>(ypos) / CELL_SIZE, static_cast<int>(xpos) / CELL_SIZE }); /* (row, column) */
     }
-    grid.swap(std::move(writeLock));
+    grid.publish();
 }
 
 /* This function runs once per frame, and is the heart of the program. */
 SDL_AppResult SDL_AppIterate(void* appstate)
 {
-    static GridType grid;
-    SimStep(grid);
+    SimStep(*grid);
 
-    /* Rewrite the grid texture: white = alive, black = dead (ARGB8888). */
+    /* Rewrite the grid texture, in parallel on the grid's bands (render pool).
+       Texture row = screen y = grid row; column = screen x = grid column. */
     void* texPixels = NULL;
     int pitch = 0;
     if (SDL_LockTexture(texture, NULL, &texPixels, &pitch)) {
-        const auto [currGrid, lock] = grid.readBuffer();
-        for (int j = 0; j < GRID_SIZE; ++j) { /* texture row = screen y */
-            Uint32* const row = reinterpret_cast<Uint32*>(static_cast<Uint8*>(texPixels) + (j * pitch));
-            for (int i = 0; i < GRID_SIZE; ++i) { /* column = screen x */
-                row[i] = currGrid.get({ i, j }) ? 0xFFFFFFFFu : 0xFF000000u;
-            }
-        }
+        const DynamicGrid& currGrid = grid->latest();
+        renderGrid(currGrid, palette, static_cast<Uint32*>(texPixels), static_cast<size_t>(pitch) / sizeof(Uint32));
         SDL_UnlockTexture(texture);
     }
 
@@ -96,6 +98,18 @@ SDL_AppResult SDL_AppIterate(void* appstate)
     SDL_RenderTexture(renderer, texture, NULL, NULL); /* scale to fill the window */
     SDL_RenderPresent(renderer);
 
+    /* Worker pool timings, logged every second in GOL_BAND_STATS builds. */
+    if constexpr (BAND_STATS_ENABLED) {
+        static Uint64 bandStatsTicks = 0;
+        const Uint64 now = SDL_GetTicks();
+        if (now - bandStatsTicks >= 1000) {
+            const DynamicGrid& currGrid = grid->latest();
+            SDL_Log("%s", bandStatsSummary(currGrid.bandStats()).c_str());
+            currGrid.resetBandStats();
+            bandStatsTicks = now;
+        }
+    }
+
     return SDL_APP_CONTINUE; /* carry on with the program! */
 }
 
@@ -103,5 +117,6 @@ SDL_AppResult SDL_AppIterate(void* appstate)
 void SDL_AppQuit(void* appstate, SDL_AppResult result)
 {
     SDL_DestroyTexture(texture);
+    grid.reset();
     /* SDL will clean up the window/renderer for us. */
 }
@@ -2,6 +2,7 @@
 // Copyright (c) 2025 Faraz Fallahi <fffaraz@gmail.com>
 
 #include "Common.hpp"
+#include "Render.hpp"
 
 #include <SFML/Graphics.hpp>
 
@@ -19,20 +20,17 @@ std::atomic_bool mouseLeftPressed = false;
 static void updateGrid(GridType& grid, const sf::RenderWindow& window)
 {
     // Get the writable next grid
-    auto [nextGrid, writeLock] = grid.writeBuffer();
+    DynamicGrid& nextGrid = grid.back();
 
     // Handle right mouse button click
     if (mouseRightPressed.load()) {
         nextGrid.clear(); // Clear the grid
-        grid.swap(std::move(writeLock));
+        grid.publish();
         return;
     }
 
-    // Get the current grid and update nextGrid - scope ensures readLock is released
-    {
-        const auto [currGrid, readLock] = grid.readBuffer();
-        nextGrid.updateGrid(currGrid);
-    }
+    // Step from the last published grid
+    nextGrid.updateGrid(grid.current());
 
     // Add random noise to the grid
     nextGrid.addNoise();
@@ -40,64 +38,64 @@ static void updateGrid(GridType& grid, const sf::RenderWindow& window)
     // Handle mouse movement while the left button is pressed
     if (mouseLeftPressed.load()) {
         const sf::Vector2i mousePos = sf::Mouse::getPosition(window);
-        const int x = mousePos.x / CELL_SIZE;
-        const int y = mousePos.y / CELL_SIZE;
-        if (x >= 0 && x < GRID_SIZE && y >= 0 && y < GRID_SIZE) {
-            nextGrid.toggleBlock({ x, y }); // Toggle a 3x3 block
+        const int row = mousePos.y / CELL_SIZE;
+        const int col = mousePos.x / CELL_SIZE;
+        if (row >= 0 && row < nextGrid.height() && col >= 0 && col < nextGrid.width()) {
+            nextGrid.toggleBlock({ row, col }); // Toggle a 3x3 block
         }
     }
 
-    // Swap the buffers
-    grid.swap(std::move(writeLock));
+    // Publish it to the renderer
+    grid.publish();
+}
+
+// Pixel for a color, in the texture's RGBA byte order.
+static std::uint32_t pixelOf(const sf::Color& c)
+{
+    return rgbaPixel(c.r, c.g, c.b, c.a);
 }
 
+#if 1 // Enable to color cells based on live neighbors
 // Color map for cells based on the number of live neighbors
-static const std::array<sf::Color, 9> colorMap {
-    sf::Color::Red, // 0 live neighbors
-    sf::Color::Green, // 1 live neighbor
-    sf::Color::Blue, // 2 live neighbors
-    sf::Color::Cyan, // 3 live neighbors
-    sf::Color::Magenta, // 4 live neighbors
-    sf::Color::Yellow, // 5 live neighbors
-    sf::Color::White, // 6 live neighbors
-    sf::Color::White, // 7 live neighbors
-    sf::Color::White, // 8 live neighbors
+static const Palette palette {
+    pixelOf(sf::Color::Black),
+    {
+        pixelOf(sf::Color::Red), // 0 live neighbors
+        pixelOf(sf::Color::Green), // 1 live neighbor
+        pixelOf(sf::Color::Blue), // 2 live neighbors
+        pixelOf(sf::Color::Cyan), // 3 live neighbors
+        pixelOf(sf::Color::Magenta), // 4 live neighbors
+        pixelOf(sf::Color::Yellow), // 5 live neighbors
+        pixelOf(sf::Color::White), // 6 live neighbors
+        pixelOf(sf::Color::White), // 7 live neighbors
+        pixelOf(sf::Color::White), // 8 live neighbors
+    },
 };
+#else
+static const std::uint32_t white = pixelOf(sf::Color::White);
+static const Palette palette { pixelOf(sf::Color::Black), { white, white, white, white, white, white, white, white, white } };
+#endif
 
 // Rewrite the RGBA pixel buffer from the grid; returns the live-cell count. One
 // pixel per cell (the texture is scaled up by CELL_SIZE at draw time), replacing
-// the old per-cell vertex array of up to 6 vertices per cell.
-int fillPixels(GridType& grid, std::vector<std::uint8_t>& pixels)
+// the old per-cell vertex array of up to 6 vertices per cell. The conversion
+// runs in parallel on the grid's bands, on the render pool.
+long long fillPixels(GridType& grid, std::vector<std::uint32_t>& pixels)
 {
-    int numAlive = 0;
-    const auto [currGrid, lock] = grid.readBuffer();
-    for (int j = 0; j < GRID_SIZE; ++j) { // texture row = screen y
-        for (int i = 0; i < GRID_SIZE; ++i) { // texture column = screen x
-            const Point p { i, j };
-            const bool cellAlive = currGrid.get(p);
-            numAlive += cellAlive ? 1 : 0;
-#if 1 // Enable to color cells based on live neighbors
-            const sf::Color color = cellAlive ? colorMap[currGrid.countLiveNeighbors(p)] : sf::Color::Black;
-#else
-            const sf::Color color = cellAlive ? sf::Color::White : sf::Color::Black;
-#endif
-            const std::size_t idx = ((static_cast<std::size_t>(j) * GRID_SIZE) + i) * 4;
-            pixels[idx + 0] = color.r;
-            pixels[idx + 1] = color.g;
-            pixels[idx + 2] = color.b;
-            pixels[idx + 3] = color.a;
-        }
-    }
-    return numAlive; // Return the number of alive cells
+    const DynamicGrid& currGrid = grid.latest();
+    renderGrid(currGrid, palette, pixels.data(), static_cast<std::size_t>(currGrid.width()));
+    return currGrid.population(); // a popcount per word, not per cell
 }
 
-int main()
+int main(int argc, char** argv)
 {
-    printAppInfo();
+    const GridSize gridSize = gridSizeFromArgs(argc, argv);
+    const sf::Vector2u texSize { static_cast<unsigned>(gridSize.width), static_cast<unsigned>(gridSize.height) };
+    printAppInfo(gridSize);
     std::cout << "SFML version: " << SFML_VERSION_MAJOR << "." << SFML_VERSION_MINOR << "." << SFML_VERSION_PATCH << "\n";
 
     // Create the main window
-    sf::RenderWindow window(sf::VideoMode({ GRID_SIZE * CELL_SIZE, GRID_SIZE * CELL_SIZE }), "Conway's Game of Life");
+    sf::RenderWindow window(sf::VideoMode(texSize * static_cast<unsigned>(CELL_SIZE)), "Conway's Game of Life");
     if (targetFPS > 0) {
         window.setFramerateLimit(targetFPS);
         std::cout << "Framerate Limit: " << targetFPS << "\n";
@@ -107,11 +105,11 @@ int main()
     // One texture holds the whole grid at 1 pixel/cell, scaled up by CELL_SIZE via
     // the sprite. Rewritten and uploaded once per frame instead of a per-cell mesh.
     sf::Texture texture;
-    if (!texture.resize({ GRID_SIZE, GRID_SIZE })) {
+    if (!texture.resize(texSize)) {
         std::cerr << "Failed to create grid texture\n";
         return 1;
     }
-    std::vector<std::uint8_t> pixels(static_cast<std::size_t>(GRID_SIZE) * GRID_SIZE * 4);
+    std::vector<std::uint32_t> pixels(static_cast<std::size_t>(gridSize.width) * gridSize.height);
     sf::Sprite sprite(texture);
     sprite.setScale({ static_cast<float>(CELL_SIZE), static_cast<float>(CELL_SIZE) });
 
@@ -144,9 +142,14 @@ int main()
     txtFPS.setOutlineThickness(2);
     txtFPS.setOutlineColor(sf::Color::Black);
 
-    // Heap-allocated: a GridType holds two grids inline (~8 MB at GRID_SIZE 2048),
-    // which overflows the stack if placed as a local.
-    auto gridPtr = std::make_unique<GridType>();
+    // Worker pool timings, in GOL_BAND_STATS builds.
+    sf::Text txtBands(font, "", 18);
+    txtBands.setFillColor(sf::Color::White);
+    txtBands.setPosition({ 10, (float)window.getSize().y - 30 });
+    txtBands.setOutlineThickness(2);
+    txtBands.setOutlineColor(sf::Color::Black);
+
+    auto gridPtr = std::make_unique<GridType>(gridSize.width, gridSize.height);
     GridType& grid = *gridPtr;
 
     // Start the grid update thread
@@ -195,8 +198,8 @@ int main()
         }
 
         // Rebuild the grid texture from the latest state.
-        const int numAlive = fillPixels(grid, pixels);
-        texture.update(pixels.data());
+        const long long numAlive = fillPixels(grid, pixels);
+        texture.update(reinterpret_cast<const std::uint8_t*>(pixels.data()));
         txtNumAlive.setString("Alive: " + std::to_string(numAlive));
 
         // Update FPS counter
@@ -204,10 +207,15 @@ int main()
         if (fpsClock.getElapsedTime().asSeconds() >= 1.0f) {
             const float fps = frameCount / fpsClock.getElapsedTime().asSeconds();
             const float eps = epochsPerSecond.load();
-            const float cups = eps * (GRID_SIZE * GRID_SIZE / 1'000'000'000.0);
+            const float cups = eps * (static_cast<double>(gridSize.width) * gridSize.height / 1'000'000'000.0);
             char buffer[50];
             snprintf(buffer, sizeof(buffer), "FPS: %.2f\nEPS: %.2f\nCUpS: %.3fe9", fps, eps, cups);
             txtFPS.setString(buffer);
+            if constexpr (BAND_STATS_ENABLED) {
+                const DynamicGrid& latest = grid.latest();
+                txtBands.setString(bandStatsSummary(latest.bandStats()));
+                latest.resetBandStats();
+            }
             frameCount = 0;
             fpsClock.restart();
         }
@@ -219,6 +227,7 @@ int main()
         window.draw(sprite);
         window.draw(txtNumAlive);
         window.draw(txtFPS);
+        window.draw(txtBands);
 
         // Update the window
         window.display();
@@ -6,11 +6,41 @@
 // two things the SWAR rewrite could get wrong -- 64-cell word boundaries and the
 // non-toroidal grid edges. Exit code is nonzero if any check fails.
 
+#include "Affinity.hpp"
+#include "BandExecutor.hpp"
+#include "BatchLife.hpp"
+#include "Checkpoint.hpp"
+#include "CycleDetector.hpp"
 #include "Grid.hpp"
+#include "HashLife.hpp"
+#include "PatternIO.hpp"
+#include "Recording.hpp"
+#include "Render.hpp"
+#include "SparseLife.hpp"
+#include "TripleBuffer.hpp"
+#include "Tuner.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cmath>
 #include <cstdint>
 #include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <future>
 #include <initializer_list>
+#include <iterator>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 namespace {
 
@@ -32,7 +62,12 @@ int g_failures = 0;
         }                                                                 \
     } while (0)
 
-void setCells(G& g, std::initializer_list<Point> pts)
+struct GridSizeCase {
+    int width;
+    int height;
+};
+
+void setCells(DynamicGrid& g, std::initializer_list<Point> pts)
 {
     for (const auto& p : pts) {
         g.set(p, true);
@@ -290,22 +325,23 @@ void test_non_toroidal_edges()
 // Generic helpers for a grid size that actually gets multiple worker bands. The
 // pattern tests above run on Grid<N=128>, which the size-aware thread heuristic
 // (>=128 rows/band) deliberately runs single-threaded.
-template <int S>
-Grid<S> evolve(Grid<S> g, int n)
+DynamicGrid evolve(DynamicGrid g, int n)
 {
+    DynamicGrid d(g.width(), g.height());
     for (int i = 0; i < n; ++i) {
-        Grid<S> d;
         d.updateGrid(g);
-        g = d;
+        std::swap(g, d);
     }
     return g;
 }
 
-template <int S>
-bool sameGrid(const Grid<S>& a, const Grid<S>& b)
+bool sameGrid(const DynamicGrid& a, const DynamicGrid& b)
 {
-    for (int x = 0; x < S; ++x) {
-        for (int y = 0; y < S; ++y) {
+    if (a.width() != b.width() || a.height() != b.height()) {
+        return false;
+    }
+    for (int x = 0; x < a.height(); ++x) {
+        for (int y = 0; y < a.width(); ++y) {
             if (a.get({ x, y }) != b.get({ x, y })) {
                 return false;
             }
@@ -314,32 +350,26 @@ bool sameGrid(const Grid<S>& a, const Grid<S>& b)
     return true;
 }
 
-template <int S>
-int aliveCount(const Grid<S>& g)
+int aliveCount(const DynamicGrid& g)
 {
     int c = 0;
-    for (int x = 0; x < S; ++x) {
-        for (int y = 0; y < S; ++y) {
+    for (int x = 0; x < g.height(); ++x) {
+        for (int y = 0; y < g.width(); ++y) {
             c += g.get({ x, y }) ? 1 : 0;
         }
     }
     return c;
 }
 
-// The parallel band executor must produce identical results run to run. A 256-row
-// grid gets 2 worker bands (boundary at row 128); speckling live cells across every
-// row means both bands and their shared halo rows are active, so a data race at a
-// band edge would diverge the two runs.
-void test_parallel_determinism()
+// Irregular ~50% "soup" (a hashed fill, not a regular lattice) so it stays busy
+// for the whole run instead of collapsing -- otherwise two runs being compared
+// would agree only by both dying out.
+DynamicGrid hashedSoup(int width, int height)
 {
-    constexpr int S = 256;
-    Grid<S> g;
+    DynamicGrid g(width, height);
     g.clear();
-    // Irregular ~50% "soup" (a hashed fill, not a regular lattice) so it stays busy
-    // for the whole run instead of collapsing -- otherwise the two runs would agree
-    // only by both dying out.
-    for (int x = 0; x < S; ++x) {
-        for (int y = 0; y < S; ++y) {
+    for (int x = 0; x < height; ++x) {
+        for (int y = 0; y < width; ++y) {
             uint32_t h = (static_cast<uint32_t>(x) * 73856093u) ^ (static_cast<uint32_t>(y) * 19349663u);
             h ^= h >> 13;
             h *= 0x5bd1e995u;
@@ -349,12 +379,1378 @@ void test_parallel_determinism()
             }
         }
     }
-    const Grid<S> a = evolve(g, 20);
-    const Grid<S> b = evolve(g, 20);
+    return g;
+}
+
+// Cell-by-cell reference generation built on the bounds-checked
+// countLiveNeighbors, independent of the SWAR kernels.
+DynamicGrid referenceStep(const DynamicGrid& g)
+{
+    DynamicGrid next(g.width(), g.height());
+    next.setBoundary(g.boundary());
+    next.setRule(g.rule());
+    next.clear();
+    for (int x = 0; x < g.height(); ++x) {
+        for (int y = 0; y < g.width(); ++y) {
+            const int n = g.countLiveNeighbors({ x, y });
+            next.set({ x, y }, g.rule().next(g.get({ x, y }), n));
+        }
+    }
+    return next;
+}
+
+const std::initializer_list<Boundary> ALL_BOUNDARIES = { Boundary::Dead, Boundary::Torus, Boundary::Reflect, Boundary::Alive };
+// Widths that end in a full word (64, 128), a partial word, or are a single
+// word; 3- and 1-row grids make the top and bottom rows each other's (or their
+// own) neighbors.
+const std::initializer_list<GridSizeCase> EDGE_SIZES = { { 1, 5 }, { 37, 41 }, { 64, 64 }, { 130, 3 }, { 128, 1 }, { 1000, 70 } };
+
+// hashedSoup confined to the middle third of an otherwise empty grid, rows and
+// columns, so that once it settles ping-pong updates skip the words around it.
+DynamicGrid confinedSoup(const GridSizeCase& c, Boundary b)
+{
+    const DynamicGrid soup = hashedSoup(c.width, c.height);
+    DynamicGrid g(c.width, c.height);
+    g.setBoundary(b);
+    g.clear();
+    for (int x = c.height / 3; x < 2 * c.height / 3 + 1; ++x) {
+        for (int y = c.width / 3; y < 2 * c.width / 3; ++y) {
+            g.set({ x, y }, soup.get({ x, y }));
+        }
+    }
+    return g;
+}
+
+// CHECK check(b, c) for every boundary mode and size, printing each case that
+// fails (after `label`, e.g. the SIMD level, if given) so the report says which.
+template <typename F>
+void checkCases(const char* label, std::initializer_list<Boundary> boundaries, std::initializer_list<GridSizeCase> sizes, F&& check)
+{
+    for (const Boundary b : boundaries) {
+        for (const GridSizeCase& c : sizes) {
+            const bool same = check(b, c);
+            if (!same) {
+                std::printf("    %s%s%s / %dx%d\n", label != nullptr ? label : "", label != nullptr ? " / " : "", boundaryName(b), c.width, c.height);
+            }
+            CHECK(same);
+        }
+    }
+}
+
+// fn(level) at every SIMD level this CPU has, then back to the active one.
+template <typename F>
+void forEachSimdLevel(F&& fn)
+{
+    const SimdLevel saved = activeSimdLevel();
+    for (const SimdLevel level : { SimdLevel::Scalar, SimdLevel::Avx2, SimdLevel::Avx512 }) {
+        if (setSimdLevel(level) == level) {
+            fn(level);
+        }
+    }
+    setSimdLevel(saved);
+}
+
+// The parallel band executor must produce identical results run to run. A 256-row
+// grid gets 2 worker bands (boundary at row 128); speckling live cells across every
+// row means both bands and their shared halo rows are active, so a data race at a
+// band edge would diverge the two runs.
+void test_parallel_determinism()
+{
+    const DynamicGrid g = hashedSoup(256, 256);
+    const DynamicGrid a = evolve(g, 20);
+    const DynamicGrid b = evolve(g, 20);
     CHECK(sameGrid(a, b));
     CHECK(aliveCount(a) > 0); // guards against a vacuous empty == empty pass
 }
 
+// Every SIMD kernel this CPU supports must match the scalar kernel bit for bit.
+// The widths cover each shape a row can take: exactly one vector step (4 words
+// for AVX2, 8 for AVX-512), several steps ending flush at the right edge, and
+// 10/15 words/row where a scalar remainder follows the last step; 1000 adds a
+// partial last word.
+void checkSimdMatchesScalar(int width)
+{
+    const DynamicGrid g = hashedSoup(width, 96);
+    const SimdLevel saved = activeSimdLevel();
+    setSimdLevel(SimdLevel::Scalar);
+    const DynamicGrid expected = evolve(g, 12);
+    for (const SimdLevel level : { SimdLevel::Avx2, SimdLevel::Avx512 }) {
+        if (setSimdLevel(level) != level) {
+            std::printf("    (skipping %s: not supported here)\n", simdLevelName(level));
+            continue;
+        }
+        const DynamicGrid actual = evolve(g, 12);
+        CHECK(sameGrid(actual, expected));
+    }
+    setSimdLevel(saved);
+    CHECK(aliveCount(expected) > 0);
+}
+
+void test_simd_kernels()
+{
+    for (const int width : { 256, 512, 640, 960, 1000 }) {
+        checkSimdMatchesScalar(width);
+    }
+}
+
+// Runtime-sized grids: 192 columns = 3 words/row, which no fixed-width kernel
+// covers, so this runs the runtime-width kernel on every SIMD level.
+void test_dynamic_grid()
+{
+    DynamicGrid g(192);
+    CHECK(g.width() == 192 && g.height() == 192);
+    g.clear();
+    setCells(g, { { 100, 127 }, { 100, 128 }, { 100, 129 } }); // straddles words 1/2
+    DynamicGrid next(192);
+    next.updateGrid(g);
+    CHECK(next.get({ 99, 128 }) && next.get({ 100, 128 }) && next.get({ 101, 128 }));
+    CHECK(!next.get({ 100, 127 }) && !next.get({ 100, 129 }));
+
+    // Right-edge blinker decays exactly as on the fixed-size grids.
+    g.clear();
+    setCells(g, { { 10, 191 }, { 11, 191 }, { 12, 191 } });
+    next.updateGrid(g);
+    CHECK(next.get({ 11, 190 }) && next.get({ 11, 191 }));
+
+    bool threw = false;
+    try {
+        DynamicGrid bad(0, 10);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    CHECK(threw);
+}
+
+// Rectangular grids of any width: the last word of each row is partial, and a
+// birth just past the right edge must never happen (or leak back in as a
+// neighbor). Every generation is checked against the cell-by-cell reference.
+void test_rectangular_grid()
+{
+    // Vertical blinker on the last column of a 100-wide grid: its horizontal phase
+    // would need column 100, which does not exist.
+    DynamicGrid g(100, 20);
+    g.clear();
+    setCells(g, { { 9, 99 }, { 10, 99 }, { 11, 99 } });
+    const DynamicGrid g1 = evolve(g, 1);
+    CHECK(aliveCount(g1) == 2 && g1.get({ 10, 98 }) && g1.get({ 10, 99 }));
+    CHECK(aliveCount(evolve(g, 2)) == 0);
+
+    const Grid<70, 3> fixed;
+    CHECK(fixed.width() == 70 && fixed.height() == 3);
+
+    checkCases(nullptr, { Boundary::Dead }, { { 1, 5 }, { 37, 41 }, { 100, 37 }, { 1000, 70 }, { 1536, 300 } }, [](Boundary, const GridSizeCase& c) {
+        DynamicGrid soup = hashedSoup(c.width, c.height);
+        bool same = true;
+        for (int i = 0; i < 6 && same; ++i) {
+            const DynamicGrid expected = referenceStep(soup);
+            soup = evolve(soup, 1);
+            same = sameGrid(soup, expected);
+        }
+        return same;
+    });
+}
+
+// Every boundary mode against the cell-by-cell reference, on the EDGE_SIZES
+// and every SIMD level this CPU has.
+void test_boundary_modes()
+{
+    forEachSimdLevel([](SimdLevel level) {
+        checkCases(simdLevelName(level), ALL_BOUNDARIES, EDGE_SIZES, [](Boundary b, const GridSizeCase& c) {
+            DynamicGrid soup = hashedSoup(c.width, c.height);
+            soup.setBoundary(b);
+            bool same = true;
+            for (int i = 0; i < 6 && same; ++i) {
+                const DynamicGrid expected = referenceStep(soup);
+                soup = evolve(soup, 1);
+                same = sameGrid(soup, expected) && soup.boundary() == b;
+            }
+            return same;
+        });
+    });
+
+    // On a torus a blinker on the top edge keeps oscillating through row 0 and
+    // the bottom row instead of decaying, and a glider comes back to where it
+    // started after crossing every edge: (+1,+1) per 4 gens, 4*64 gens on 64x64.
+    DynamicGrid blinker(64, 64);
+    blinker.setBoundary(Boundary::Torus);
+    blinker.clear();
+    setCells(blinker, { { 0, 10 }, { 0, 11 }, { 0, 12 } });
+    const DynamicGrid b1 = evolve(blinker, 1);
+    CHECK(aliveCount(b1) == 3 && b1.get({ 63, 11 }) && b1.get({ 0, 11 }) && b1.get({ 1, 11 }));
+    CHECK(sameGrid(evolve(blinker, 2), blinker));
+
+    DynamicGrid glider(64, 64);
+    glider.setBoundary(Boundary::Torus);
+    glider.clear();
+    setCells(glider, { { 60, 61 }, { 61, 62 }, { 62, 60 }, { 62, 61 }, { 62, 62 } });
+    CHECK(sameGrid(evolve(glider, 4 * 64), glider));
+    CHECK(!sameGrid(evolve(glider, 4 * 32), glider));
+
+    Boundary parsed = Boundary::Dead;
+    CHECK(parseBoundary("reflect", parsed) && parsed == Boundary::Reflect);
+    CHECK(!parseBoundary("klein", parsed));
+}
+
+// neighborPlanes must give countLiveNeighbors for every cell, across the same
+// widths, boundary modes and SIMD levels, and leave the bits past the edge clear.
+void test_neighbor_planes()
+{
+    forEachSimdLevel([](SimdLevel level) {
+        checkCases(simdLevelName(level), ALL_BOUNDARIES, EDGE_SIZES, [](Boundary b, const GridSizeCase& c) {
+            DynamicGrid soup = hashedSoup(c.width, c.height);
+            soup.setBoundary(b);
+            const int wpr = soup.wordsPerRow();
+            std::vector<uint64_t> planes(4 * static_cast<std::size_t>(wpr));
+            bool same = true;
+            for (int x = 0; x < c.height; ++x) {
+                soup.neighborPlanes(x, planes.data());
+                for (int y = 0; y < wpr * 64; ++y) {
+                    int n = 0;
+                    for (int k = 0; k < 4; ++k) {
+                        n |= static_cast<int>((planes[(k * wpr) + (y >> 6)] >> (y & 63)) & 1) << k;
+                    }
+                    same = same && n == (y < c.width ? soup.countLiveNeighbors({ x, y }) : 0);
+                }
+            }
+            return same;
+        });
+    });
+
+    // A fully surrounded cell reaches a count of 8, the one that needs plane 3.
+    DynamicGrid full(70, 3);
+    full.clear();
+    for (int y = 0; y < 70; ++y) {
+        setCells(full, { { 0, y }, { 1, y }, { 2, y } });
+    }
+    std::vector<uint64_t> planes(4 * static_cast<std::size_t>(full.wordsPerRow()));
+    full.neighborPlanes(1, planes.data());
+    CHECK(((planes[3 * 2] >> 1) & 1) == 1 && ((planes[(3 * 2) + 1] >> 4) & 1) == 1 && ((planes[(3 * 2) + 1] >> 5) & 1) == 0);
+    CHECK(full.row(1)[1] == (1ULL << 6) - 1);
+}
+
+// renderGrid must paint every cell with its palette entry, band by band, and
+// leave the pitch padding past each row alone.
+void test_render()
+{
+    const Palette colors { 100, { 0, 1, 2, 3, 4, 5, 6, 7, 8 } };
+    const Palette mono { 100, { 7, 7, 7, 7, 7, 7, 7, 7, 7 } };
+    checkCases(nullptr, { Boundary::Dead, Boundary::Torus, Boundary::Alive }, { { 37, 41 }, { 1000, 300 } }, [&](Boundary b, const GridSizeCase& c) {
+        DynamicGrid soup = hashedSoup(c.width, c.height);
+        soup.setBoundary(b);
+        const std::size_t pitch = static_cast<std::size_t>(c.width) + 3;
+        std::vector<uint32_t> pixels(pitch * c.height, 999);
+        std::vector<uint32_t> plain(pitch * c.height, 999);
+        renderGrid(soup, colors, pixels.data(), pitch);
+        renderGrid(soup, mono, plain.data(), pitch);
+        bool same = true;
+        for (int x = 0; x < c.height; ++x) {
+            for (int y = 0; y < c.width; ++y) {
+                const bool alive = soup.get({ x, y });
+                same = same && pixels[(x * pitch) + y] == (alive ? static_cast<uint32_t>(soup.countLiveNeighbors({ x, y })) : 100);
+                same = same && plain[(x * pitch) + y] == (alive ? 7 : 100);
+            }
+            for (std::size_t y = c.width; y < pitch; ++y) {
+                same = same && pixels[(x * pitch) + y] == 999 && plain[(x * pitch) + y] == 999;
+            }
+        }
+        return same;
+    });
+    CHECK(rgbaPixel(1, 2, 3, 4) == (std::endian::native == std::endian::little ? 0x04030201u : 0x01020304u));
+}
+
+// A render pass held open (a slow frame) must not hold up the next update,
+// although both split the same rows into the same bands.
+void test_render_overlap()
+{
+    const DynamicGrid shown = hashedSoup(256, 256);
+    DynamicGrid next(256, 256);
+    std::atomic<bool> inside { false };
+    std::atomic<bool> release { false };
+    std::thread renderer([&] {
+        shown.forEachRenderBand([&](int begin, int) {
+            if (begin == 0) {
+                inside = true;
+                while (!release) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    });
+    while (!inside) {
+        std::this_thread::yield();
+    }
+    auto update = std::async(std::launch::async, [&] { next.updateGrid(shown); });
+    const bool finished = update.wait_for(std::chrono::seconds(10)) == std::future_status::ready;
+    release = true;
+    renderer.join();
+    update.wait();
+    CHECK(finished);
+    CHECK(sameGrid(next, referenceStep(shown)));
+}
+
+// TripleBuffer: the reader sees the newest published buffer, never one the
+// writer is filling, and generations only move forward.
+void test_triple_buffer()
+{
+    TripleBuffer<std::vector<int>> buf(256, 0);
+    CHECK(buf.latest()[0] == 0);
+    buf.back().assign(256, 1);
+    buf.publish();
+    CHECK(buf.current()[0] == 1);
+    buf.back().assign(256, 2);
+    buf.publish();
+    CHECK(buf.latest()[0] == 2 && &buf.latest() == &buf.current());
+    CHECK(&buf.back() != &buf.current() && &buf.back() != &buf.latest());
+
+    constexpr int GENERATIONS = 20000;
+    bool consistent = true;
+    std::thread writer([&buf] {
+        for (int g = 3; g <= GENERATIONS; ++g) {
+            std::vector<int>& next = buf.back();
+            for (int& v : next) {
+                v = g;
+            }
+            buf.publish();
+        }
+    });
+    int seen = 2;
+    while (seen < GENERATIONS) {
+        const std::vector<int>& front = buf.latest();
+        const int g = front[0];
+        for (const int v : front) {
+            consistent = consistent && v == g;
+        }
+        consistent = consistent && g >= seen;
+        seen = g;
+    }
+    writer.join();
+    CHECK(consistent);
+}
+
+// The pool's passes, spinning or parking at once: every band runs once per pass
+// and its writes are visible when run() returns; a stealing pass covers every
+// item exactly once, and a slow band's share, its worker parked when the pass
+// starts, is partly done by the others.
+void test_band_executor()
+{
+    for (const auto spin : { std::chrono::nanoseconds {}, std::chrono::nanoseconds { 20000 } }) {
+        BandExecutor exec(3, {}, spin);
+        CHECK(exec.spin() == spin);
+        std::vector<int> runs(3, 0);
+        bool visible = true;
+        for (int pass = 1; pass <= 500; ++pass) {
+            exec.run([&runs](int t) { ++runs[t]; });
+            visible = visible && runs == std::vector<int>(3, pass);
+        }
+        CHECK(visible);
+
+        std::vector<int> items(1000, 0);
+        for (int pass = 0; pass < 50; ++pass) {
+            exec.runStealing(static_cast<int>(items.size()), 7, [&items](int, int begin, int end) {
+                for (int i = begin; i < end; ++i) {
+                    ++items[i];
+                }
+            });
+        }
+        CHECK(std::all_of(items.begin(), items.end(), [](int n) { return n == 50; }));
+    }
+
+    BandExecutor parked(2, {}, std::chrono::nanoseconds {});
+    bool stolen = true;
+    for (int pass = 0; pass < 3; ++pass) {
+        std::vector<int> ranBy(40, -1);
+        parked.runStealing(static_cast<int>(ranBy.size()), 1, [&ranBy](int t, int begin, int end) {
+            if (t == 1) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            }
+            for (int i = begin; i < end; ++i) {
+                ranBy[i] = t;
+            }
+        });
+        stolen = stolen && std::count(ranBy.begin() + 20, ranBy.end(), 0) > 0 && std::count(ranBy.begin(), ranBy.end(), -1) == 0;
+    }
+    CHECK(stolen);
+}
+
+// Every schedule and thread count gives the same generations and stats, on a
+// soup confined to the top rows so activity tracking skips (and Auto steals)
+// most of the grid, through single steps and temporal blocking.
+void test_schedules()
+{
+    constexpr int SOUP_ROWS = 64;
+    for (const Boundary boundary : { Boundary::Dead, Boundary::Torus }) {
+        DynamicGrid seed = hashedSoup(300, 700);
+        for (int x = SOUP_ROWS; x < seed.height(); ++x) {
+            std::fill_n(seed.rowForEdit(x), seed.wordsPerRow(), 0);
+        }
+        seed.endEdits();
+        seed.setBoundary(boundary);
+        seed.setCollectStats(true);
+        const auto run = [&seed](Schedule schedule, int threads, std::vector<long long>& populations) {
+            DynamicGrid a = seed;
+            DynamicGrid b(seed.width(), seed.height());
+            a.setSchedule(schedule);
+            a.setThreads(threads);
+            b.setThreads(threads);
+            DynamicGrid* curr = &a;
+            DynamicGrid* next = &b;
+            for (int gen = 0; gen < 40; ++gen) {
+                next->updateGrid(*curr, gen < 30 ? 1 : 5);
+                std::swap(curr, next);
+                const std::optional<GenerationStats> stats = curr->stats();
+                populations.push_back(stats ? stats->population : -1);
+            }
+            return *curr;
+        };
+        std::vector<long long> expectedPopulations;
+        const DynamicGrid expected = run(Schedule::Static, 1, expectedPopulations);
+        CHECK(aliveCount(expected) > 0);
+        for (const Schedule schedule : { Schedule::Auto, Schedule::Static, Schedule::Stealing }) {
+            for (const int threads : { 2, 3, 4 }) {
+                std::vector<long long> populations;
+                const bool same = sameGrid(run(schedule, threads, populations), expected) && populations == expectedPopulations;
+                if (!same) {
+                    std::printf("    %s / %s / %d threads\n", boundaryName(boundary), scheduleName(schedule), threads);
+                }
+                CHECK(same);
+            }
+        }
+    }
+
+    Schedule schedule = Schedule::Auto;
+    CHECK(parseSchedule("stealing", schedule) && schedule == Schedule::Stealing && !parseSchedule("dynamic", schedule));
+}
+
+// CPU lists parse and print like taskset's; a grid moved to another pool (new
+// thread count or pinned cores) keeps its cells, and pinned workers step it the
+// same as unpinned ones.
+void test_affinity()
+{
+    std::vector<int> cores;
+    CHECK(parseCpuList("0-3,8,10-11", cores) && cores == (std::vector<int> { 0, 1, 2, 3, 8, 10, 11 }));
+    CHECK(cpuListString(cores) == "0-3,8,10-11" && cpuListString({ 5, 4 }) == "5,4");
+    CHECK(!parseCpuList("", cores) && !parseCpuList("3-1", cores) && !parseCpuList("1,", cores) && !parseCpuList("a", cores));
+
+    const DynamicGrid seed = hashedSoup(200, 300);
+    const DynamicGrid expected = evolve(seed, 10);
+    DynamicGrid moved = seed;
+    moved.setThreads(3);
+    CHECK(sameGrid(moved, seed) && moved.threads() == 3);
+
+    bool pinnable = false;
+    std::thread([&pinnable] { pinnable = pinCurrentThread(0); }).join();
+    const std::vector<int> saved = workerCores();
+    setWorkerCores({ 0 });
+    DynamicGrid a = seed;
+    DynamicGrid b(seed.width(), seed.height());
+    a.setThreads(2);
+    b.setThreads(2);
+    for (int gen = 0; gen < 10; gen += 2) {
+        b.updateGrid(a);
+        a.updateGrid(b);
+    }
+    setWorkerCores(saved);
+    CHECK(sameGrid(a, expected));
+    if (!pinnable) {
+        std::printf("    (pinning not supported here)\n");
+    }
+}
+
+// Calibration picks a candidate it timed, and the cache keeps one entry per
+// grid size, replacing it on a new result and leaving foreign lines alone.
+void test_tuner()
+{
+    const DynamicGrid soup = hashedSoup(256, 256);
+    const Tuning tuning = calibrate(soup, std::chrono::milliseconds(60));
+    CHECK(tuning.threads >= 1 && tuning.threads <= 16 && tuning.generationsPerSecond > 0);
+    CHECK(tuning.threads > 1 || tuning.schedule == Schedule::Auto);
+
+    const std::string path = (std::filesystem::temp_directory_path() / "gol-unittest-tune.txt").string();
+    {
+        std::ofstream out(path);
+        out << "Some Other CPU | 64 | 256x256 | 32 | stealing\n";
+    }
+    CHECK(!loadTuning(path, 256, 256));
+    saveTuning(path, 256, 256, { 3, Schedule::Stealing, 0 });
+    saveTuning(path, 512, 256, { 2, Schedule::Auto, 0 });
+    saveTuning(path, 256, 256, { 4, Schedule::Auto, 0 });
+    const std::optional<Tuning> cached = loadTuning(path, 256, 256);
+    CHECK(cached && cached->threads == 4 && cached->schedule == Schedule::Auto);
+    CHECK(loadTuning(path, 512, 256) && !loadTuning(path, 256, 512));
+    std::ifstream in(path);
+    std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    CHECK(text.find("Some Other CPU") != std::string::npos && text.find("| 256x256 | 3 |") == std::string::npos);
+    std::filesystem::remove(path);
+
+    DynamicGrid g(100, 100);
+    applyTuning(g, { 2, Schedule::Stealing, 0 });
+    CHECK(g.threads() == 2 && g.schedule() == Schedule::Stealing);
+}
+
+// The batch engine against referenceStep, universe by universe: 70 universes
+// fill one group of lanes and part of a second, each a different soup, under
+// every boundary mode and a rule with a second birth count.
+void test_batch_life()
+{
+    constexpr int W = 37;
+    constexpr int H = 41;
+    constexpr int N = 70;
+    for (const Boundary b : { Boundary::Dead, Boundary::Torus, Boundary::Reflect, Boundary::Alive }) {
+        for (const Rule& rule : { Rule {}, NAMED_RULES[1].rule }) {
+            BatchLife batch(W, H, N);
+            batch.setBoundary(b);
+            batch.setRule(rule);
+            batch.setThreads(2);
+            batch.randomize(0.35, 7);
+            std::vector<DynamicGrid> grids;
+            for (int u = 0; u < N; ++u) {
+                grids.emplace_back(W, H);
+                grids.back().setBoundary(b);
+                grids.back().setRule(rule);
+                batch.store(u, grids.back());
+            }
+            batch.step(3);
+            batch.step(4);
+            bool same = true;
+            bool counted = true;
+            const std::vector<long long> populations = batch.populations();
+            DynamicGrid out(W, H);
+            for (int u = 0; u < N; ++u) {
+                for (int i = 0; i < 7; ++i) {
+                    grids[u] = referenceStep(grids[u]);
+                }
+                batch.store(u, out);
+                same = same && sameGrid(out, grids[u]);
+                counted = counted && populations[u] == aliveCount(grids[u]);
+            }
+            CHECK(same);
+            CHECK(counted);
+        }
+    }
+
+    // Universes are distinct soups near the asked density, and load/get/set
+    // address one universe only.
+    BatchLife batch(64, 64, 65);
+    batch.randomize(0.25, 1);
+    const std::vector<long long> populations = batch.populations();
+    CHECK(populations[0] != populations[1] && populations[0] > 800 && populations[0] < 1250);
+    const DynamicGrid soup = hashedSoup(64, 64);
+    batch.clear();
+    batch.load(64, soup);
+    batch.set(3, { 5, 60 }, true);
+    CHECK(batch.get(3, { 5, 60 }) && !batch.get(2, { 5, 60 }) && !batch.get(4, { 5, 60 }));
+    CHECK(batch.populations()[64] == aliveCount(soup) && batch.populations()[0] == 0);
+    bool threw = false;
+    try {
+        BatchLife empty(8, 8, 0);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    CHECK(threw);
+}
+
+// Histogram buckets cover every duration once and in order, percentiles are
+// bucket upper bounds capped at the maximum, and GOL_BAND_STATS builds count a
+// pass per update.
+void test_band_stats()
+{
+    bool ordered = true;
+    for (uint64_t ns = 0; ns < 5000; ++ns) {
+        const int b = TimeHistogram::bucketOf(ns);
+        ordered = ordered && ns <= TimeHistogram::bucketMaxNs(b) && (b == 0 || ns > TimeHistogram::bucketMaxNs(b - 1));
+    }
+    CHECK(ordered);
+    CHECK(TimeHistogram::bucketOf(UINT64_MAX) == TimeHistogram::BUCKETS - 1);
+
+    TimeHistogram h;
+    for (uint64_t ns = 1; ns <= 100; ++ns) {
+        h.add(ns * 1000);
+    }
+    CHECK(h.samples == 100 && h.maxNs == 100000 && h.meanNs() == 50500);
+    CHECK(h.percentileNs(50) >= 50000 && h.percentileNs(50) < 50000 * 5 / 4 && h.percentileNs(100) == 100000);
+
+    G a;
+    G b;
+    a.resetBandStats();
+    b.updateGrid(a);
+    a.updateGrid(b);
+    const BandStats stats = a.bandStats();
+    if constexpr (BAND_STATS_ENABLED) {
+        CHECK(stats.pass.samples == 2 && static_cast<int>(stats.work.size()) == a.threads() && stats.work[0].samples == 2);
+    } else {
+        CHECK(stats.pass.samples == 0 && stats.work.empty());
+    }
+
+    // A worker done long before a slow band 0 waits out the rest of the pass.
+    BandExecutor exec(2);
+    exec.run([](int t) {
+        if (t == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+    });
+    const BandStats slow = exec.stats();
+    if constexpr (BAND_STATS_ENABLED) {
+        CHECK(slow.doneWait[1].samples == 1 && slow.doneWait[1].totalNs >= 1000000 && slow.doneWait[0].totalNs < slow.doneWait[1].totalNs);
+    }
+}
+
+// Pattern files: hand-written RLE, .cells and Macrocell land where they should
+// (clipped at the grid's edges), every format round-trips a soup exactly, and
+// malformed files throw.
+void test_pattern_io()
+{
+    const auto load = [](DynamicGrid& g, PatternFormat format, const char* text, int64_t x0, int64_t y0) {
+        std::istringstream in(text);
+        return loadPattern(in, format, g, x0, y0);
+    };
+    G g;
+    g.clear();
+    const PatternInfo glider = load(g, PatternFormat::Rle, "#N Glider\r\n#C comment\r\nx = 3, y = 3, rule = B3/S23\r\nbob$2bo$3o!\r\n", 1, 2);
+    CHECK(glider.width == 3 && glider.height == 3 && glider.rule && *glider.rule == Rule {});
+    CHECK(onlyCellsAlive(g, { { 1, 3 }, { 2, 4 }, { 3, 2 }, { 3, 3 }, { 3, 4 } }) && g.population() == 5);
+
+    // Runs across a word boundary and past the right edge, blank rows, a
+    // line-wrapped run count, S/B rule notation, and rows above the grid.
+    g.clear();
+    const PatternInfo runs = load(g, PatternFormat::Rle, "x = 0, y = 0, rule = 23/36\n62b4o$2$1\n00b50o!", -1, 0);
+    CHECK(runs.rule && ruleName(*runs.rule) == std::string("highlife"));
+    CHECK(g.population() == 28 && g.get({ 2, 100 }) && g.get({ 2, 127 }) && !g.get({ 2, 99 }) && !g.get({ 0, 62 }));
+    g.clear();
+    load(g, PatternFormat::Rle, "x = 4, y = 1\n62b4o!", 0, 0);
+    CHECK(g.population() == 4 && g.get({ 0, 62 }) && g.get({ 0, 65 }));
+
+    g.clear();
+    const PatternInfo cells = load(g, PatternFormat::Cells, "!Name: Blinker\r\n.O\r\n\r\n..O.O\n", 126, 125);
+    CHECK(cells.width == 5 && cells.height == 3 && !cells.rule);
+    CHECK(onlyCellsAlive(g, { { 126, 126 } }));
+
+    g.clear();
+    const PatternInfo macro = load(g, PatternFormat::Macrocell, "[M2] (golly 4.0)\n#R B36/S23\n.*$..*$***$\n4 1 0 0 1\n", 2, 0);
+    CHECK(macro.width == 16 && macro.rule && ruleName(*macro.rule) == std::string("highlife"));
+    CHECK(onlyCellsAlive(g, { { 2, 1 }, { 3, 2 }, { 4, 0 }, { 4, 1 }, { 4, 2 }, { 10, 9 }, { 11, 10 }, { 12, 8 }, { 12, 9 }, { 12, 10 } }));
+
+    checkCases(nullptr, { Boundary::Dead }, { { 37, 41 }, { 1000, 70 } }, [](Boundary, const GridSizeCase& c) {
+        DynamicGrid soup = hashedSoup(c.width, c.height);
+        soup.setRule(NAMED_RULES[1].rule);
+        bool same = true;
+        for (const PatternFormat format : { PatternFormat::Rle, PatternFormat::Cells, PatternFormat::Macrocell }) {
+            std::stringstream file;
+            savePattern(file, format, soup);
+            DynamicGrid back(c.width, c.height);
+            back.clear();
+            const PatternInfo info = loadPattern(file, format, back);
+            same = same && sameGrid(back, soup) && back.population() == soup.population();
+            same = same && (format == PatternFormat::Cells || (info.rule && *info.rule == soup.rule()));
+        }
+        return same;
+    });
+
+    PatternFormat format;
+    CHECK(patternFormatForPath("dir/gun.RLE", format) && format == PatternFormat::Rle);
+    CHECK(patternFormatForPath("x.mc", format) && format == PatternFormat::Macrocell);
+    CHECK(!patternFormatForPath("x.lif", format));
+
+    const auto throws = [&](PatternFormat f, const char* text) {
+        try {
+            load(g, f, text, 0, 0);
+        } catch (const std::runtime_error&) {
+            return true;
+        }
+        return false;
+    };
+    CHECK(throws(PatternFormat::Rle, "bo$o!"));
+    CHECK(throws(PatternFormat::Rle, "x = 2, y = 1\nbz!"));
+    CHECK(throws(PatternFormat::Rle, "x = 1, y = 1, rule = B3/S23/G4\no!"));
+    CHECK(throws(PatternFormat::Cells, "O.X\n"));
+    CHECK(throws(PatternFormat::Macrocell, "[M2]\n4 1 0 0 0\n"));
+    CHECK(throws(PatternFormat::Macrocell, "[M2]\n*$\n5 1 0 0 0\n"));
+}
+
+// A checkpoint restores cells, boundary, rule and generation exactly, and the
+// restored grid steps like the original. Foreign, truncated and mis-sized files
+// are refused.
+void test_checkpoint()
+{
+    const std::string path = (std::filesystem::temp_directory_path() / "gol-unittest.ckpt").string();
+    DynamicGrid g(100, 70); // partial last word
+    g.clear();
+    g.addNoise(2000);
+    g.setBoundary(Boundary::Torus);
+    g.setRule(Rule { 0b001001000, 0b000001100 });
+    saveCheckpoint(path, g, 123456789012ULL);
+
+    const CheckpointInfo info = readCheckpointInfo(path);
+    CHECK(info.width == 100 && info.height == 70 && info.generation == 123456789012ULL);
+    DynamicGrid r(100, 70);
+    const CheckpointInfo loaded = loadCheckpoint(path, r);
+    CHECK(loaded.boundary == Boundary::Torus && loaded.rule == g.rule() && r.boundary() == Boundary::Torus && r.rule() == g.rule());
+    CHECK(std::memcmp(r.row(0), g.row(0), 70 * sizeof(uint64_t) * g.wordsPerRow()) == 0 && r.population() == g.population());
+    DynamicGrid gn(100, 70);
+    DynamicGrid rn(100, 70);
+    gn.updateGrid(g, 5);
+    rn.updateGrid(r, 5);
+    CHECK(std::memcmp(rn.row(0), gn.row(0), 70 * sizeof(uint64_t) * g.wordsPerRow()) == 0);
+
+    const auto throws = [&](DynamicGrid& grid) {
+        try {
+            loadCheckpoint(path, grid);
+        } catch (const std::runtime_error&) {
+            return true;
+        }
+        return false;
+    };
+    DynamicGrid wrongSize(70, 100);
+    CHECK(throws(wrongSize));
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 8);
+    CHECK(throws(r));
+    std::ofstream(path, std::ios::binary) << "x = 3, y = 3\nbo$2bo$3o!\n";
+    CHECK(throws(r));
+    std::filesystem::remove(path);
+}
+
+// Replaying a recording reproduces every generation, seeking forward, backward
+// and across keyframes, also from a recording whose index and last frame were
+// lost.
+void test_recording()
+{
+    const std::string path = (std::filesystem::temp_directory_path() / "gol-unittest.golrec").string();
+    const std::size_t bytes = 70 * sizeof(uint64_t) * 2;
+    DynamicGrid a(100, 70);
+    DynamicGrid b(100, 70);
+    a.clear();
+    a.addNoise(1500);
+    a.setBoundary(Boundary::Torus);
+    std::vector<std::vector<uint64_t>> history;
+    {
+        Recorder recorder(path, a, 1000, 16);
+        DynamicGrid* curr = &a;
+        DynamicGrid* next = &b;
+        history.emplace_back(curr->row(0), curr->row(0) + (bytes / sizeof(uint64_t)));
+        for (int i = 0; i < 100; ++i) {
+            next->updateGrid(*curr);
+            std::swap(curr, next);
+            recorder.record(*curr);
+            history.emplace_back(curr->row(0), curr->row(0) + (bytes / sizeof(uint64_t)));
+        }
+        CHECK(recorder.lastGeneration() == 1100);
+    }
+    {
+        // Unchanged generations are a bare frame header; a blinker phase is a
+        // header, one token word and the five words from the first changed one
+        // (row 29, word 1) to the last (row 31, word 1).
+        DynamicGrid blinker(100, 70);
+        blinker.clear();
+        for (int y = 63; y < 66; ++y) {
+            blinker.set({ 30, y }, true);
+        }
+        Recorder recorder(path + ".blinker", blinker, 0, 1000);
+        const uint64_t keyframe = recorder.bytes();
+        for (int i = 0; i < 50; ++i) {
+            recorder.record(blinker);
+        }
+        CHECK(recorder.bytes() - keyframe == 50 * 24);
+        const uint64_t still = recorder.bytes();
+        DynamicGrid other(100, 70);
+        other.updateGrid(blinker);
+        for (int i = 0; i < 50; ++i) {
+            recorder.record(i % 2 == 0 ? other : blinker);
+        }
+        CHECK(recorder.bytes() - still == 50 * (24 + 48));
+    }
+    std::filesystem::remove(path + ".blinker");
+
+    const auto replays = [&](Replayer& replayer, std::initializer_list<int> generations) {
+        DynamicGrid g(100, 70);
+        bool same = true;
+        for (const int gen : generations) {
+            replayer.seek(1000 + gen, g);
+            same = same && replayer.generation() == static_cast<uint64_t>(1000 + gen) && std::memcmp(g.row(0), history[gen].data(), bytes) == 0;
+        }
+        return same && g.boundary() == Boundary::Torus && g.rule() == Rule {};
+    };
+    Replayer replayer(path);
+    CHECK(replayer.firstGeneration() == 1000 && replayer.lastGeneration() == 1100 && replayer.keyframes() == 7);
+    CHECK(replays(replayer, { 0, 1, 2, 17, 15, 100, 47, 48, 99, 31, 32, 33 }));
+    DynamicGrid wrongSize(70, 100);
+    bool threw = false;
+    try {
+        replayer.seek(1000, wrongSize);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    CHECK(threw);
+
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 150);
+    Replayer truncated(path);
+    CHECK(truncated.lastGeneration() < 1100 && truncated.lastGeneration() >= 1090 && truncated.keyframes() == 7);
+    CHECK(replays(truncated, { 90, 3, 64 }));
+    std::filesystem::remove(path);
+
+    // Cut off inside the index: its first (generation, offset) pairs read like
+    // a frame header (generation 0, a nonzero keyframe field, 1 token word),
+    // but generation 0 does not follow generation 3.
+    {
+        DynamicGrid g(100, 70);
+        g.clear();
+        Recorder recorder(path, g, 0, 1);
+        for (int i = 0; i < 3; ++i) {
+            recorder.record(g);
+        }
+    }
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 48);
+    Replayer cut(path);
+    CHECK(cut.firstGeneration() == 0 && cut.lastGeneration() == 3 && cut.keyframes() == 4);
+    std::filesystem::remove(path);
+}
+
+// updateGrid(current, k) must equal k single generations in every boundary mode,
+// including k past the grid height (halos that wrap or clip more than once).
+// The 64x200000 grid is over the per-block cache budget, so it is split into
+// several blocks whose halos overlap their neighbors'.
+void test_temporal_blocking()
+{
+    for (const int k : { 2, 5, 8 }) {
+        const std::string label = "k=" + std::to_string(k);
+        checkCases(label.c_str(), ALL_BOUNDARIES, { { 37, 41 }, { 130, 3 }, { 1000, 70 }, { 64, 200000 } }, [k](Boundary b, const GridSizeCase& c) {
+            DynamicGrid soup = hashedSoup(c.width, c.height);
+            soup.setBoundary(b);
+            DynamicGrid blocked(c.width, c.height);
+            blocked.updateGrid(soup, k);
+            return sameGrid(blocked, evolve(soup, k)) && blocked.boundary() == b;
+        });
+    }
+
+    DynamicGrid tiny(20, 4);
+    tiny.setBoundary(Boundary::Torus);
+    tiny.clear();
+    setCells(tiny, { { 1, 3 }, { 1, 4 }, { 1, 5 } });
+    DynamicGrid jumped(20, 4);
+    jumped.updateGrid(tiny, 9);
+    CHECK(sameGrid(jumped, evolve(tiny, 9)));
+
+    const DynamicGrid small(512, 512);
+    CHECK(small.generationsPerUpdate() >= 1);
+    const DynamicGrid huge(8192, 8192);
+    CHECK(huge.generationsPerUpdate() > 1);
+}
+
+// Activity tracking must never change results. `tracked` ping-pongs between two
+// grids, so once a soup confined to the middle of the grid settles, stable words
+// are skipped; `plain` steps into a fresh grid every generation, which never
+// skips. Edits to the current grid and to the stale destination must be seen.
+void test_activity_tracking()
+{
+    checkCases(nullptr, ALL_BOUNDARIES, { { 150, 120 }, { 1000, 70 }, { 64, 64 }, { 130, 3 } }, [](Boundary b, const GridSizeCase& c) {
+        DynamicGrid a = confinedSoup(c, b);
+        DynamicGrid plain = a;
+        DynamicGrid d(c.width, c.height);
+        DynamicGrid* cur = &a;
+        DynamicGrid* next = &d;
+        bool same = true;
+        for (int i = 1; i <= 400 && same; ++i) {
+            if (i == 200) {
+                cur->toggle({ c.height / 2, c.width - 1 });
+                plain.toggle({ c.height / 2, c.width - 1 });
+            }
+            if (i == 300) {
+                next->set({ 0, 0 }, true);
+            }
+            next->updateGrid(*cur);
+            std::swap(cur, next);
+            DynamicGrid fresh(c.width, c.height);
+            fresh.updateGrid(plain);
+            plain = fresh;
+            if (i % 20 == 0) {
+                same = sameGrid(*cur, plain);
+            }
+        }
+        return same;
+    });
+
+    // Change bits compare with two generations back, so a blinker counts as
+    // stable while a glider does not.
+    DynamicGrid g(128, 128);
+    g.clear();
+    setCells(g, { { 10, 3 }, { 10, 4 }, { 10, 5 } });
+    setCells(g, { { 60, 100 }, { 61, 101 }, { 62, 99 }, { 62, 100 }, { 62, 101 } });
+    DynamicGrid h(128, 128);
+    DynamicGrid* cur = &g;
+    DynamicGrid* next = &h;
+    for (int i = 0; i < 41; ++i) {
+        next->updateGrid(*cur);
+        std::swap(cur, next);
+    }
+    CHECK(!cur->wordChanged(9, 0) && !cur->wordChanged(10, 0) && !cur->wordChanged(11, 0));
+    bool gliderSeen = false;
+    for (int x = 60; x < 80; ++x) {
+        gliderSeen = gliderSeen || cur->wordChanged(x, 1);
+    }
+    CHECK(gliderSeen);
+    CHECK(!cur->wordChanged(100, 0));
+}
+
+// Births and deaths from `before` to `after`, cell by cell.
+GenerationStats cellStats(const DynamicGrid& before, const DynamicGrid& after)
+{
+    GenerationStats s;
+    for (int x = 0; x < after.height(); ++x) {
+        for (int y = 0; y < after.width(); ++y) {
+            const bool was = before.get({ x, y });
+            const bool is = after.get({ x, y });
+            s.population += is ? 1 : 0;
+            s.births += (is && !was) ? 1 : 0;
+            s.deaths += (was && !is) ? 1 : 0;
+        }
+    }
+    return s;
+}
+
+bool statsMatch(const DynamicGrid& before, const DynamicGrid& after)
+{
+    const std::optional<GenerationStats> s = after.stats();
+    const GenerationStats expected = cellStats(before, after);
+    return s && s->population == expected.population && s->births == expected.births && s->deaths == expected.deaths
+        && after.population() == expected.population;
+}
+
+// contentHash() of g computed from its words, not the fused value.
+uint64_t wordHash(const DynamicGrid& g)
+{
+    DynamicGrid copy(g.width(), g.height());
+    for (int x = 0; x < g.height(); ++x) {
+        std::copy_n(g.row(x), g.wordsPerRow(), copy.rowForEdit(x));
+    }
+    copy.endEdits();
+    return copy.contentHash();
+}
+
+// The fused hash matches the words' through every update path (full, skipping
+// stable rows, temporal blocking; one band or several), and a cycle detector
+// fed with it finds still lifes, oscillators and spaceships coming round a
+// torus.
+void test_cycle_detection()
+{
+    for (const Boundary b : { Boundary::Dead, Boundary::Torus, Boundary::Reflect, Boundary::Alive }) {
+        for (const int threads : { 1, 3 }) {
+            DynamicGrid a = confinedSoup({ 150, 120 }, b);
+            DynamicGrid d(150, 120);
+            a.setThreads(threads);
+            d.setThreads(threads);
+            DynamicGrid* cur = &a;
+            DynamicGrid* next = &d;
+            bool same = true;
+            // Turned on mid-run, once stable rows are being skipped.
+            for (int i = 0; i < 120 && same; ++i) {
+                cur->setHashGenerations(i >= 30);
+                next->updateGrid(*cur, i % 25 == 24 ? 4 : 1);
+                same = next->contentHash() == wordHash(*next);
+                std::swap(cur, next);
+            }
+            CHECK(same);
+        }
+    }
+
+    // Every kernel level hashes alike, whatever the row width's remainder.
+    const SimdLevel saved = activeSimdLevel();
+    for (const int width : { 64, 200, 1000 }) {
+        const DynamicGrid soup = hashedSoup(width, 7);
+        setSimdLevel(SimdLevel::Scalar);
+        const uint64_t scalar = wordHash(soup);
+        bool same = true;
+        for (const SimdLevel level : { SimdLevel::Avx2, SimdLevel::Avx512 }) {
+            if (setSimdLevel(level) == level) {
+                same = same && wordHash(soup) == scalar;
+            }
+        }
+        CHECK(same);
+    }
+    setSimdLevel(saved);
+
+    DynamicGrid g(100, 100);
+    const uint64_t empty = g.contentHash();
+    g.set({ 10, 70 }, true);
+    const uint64_t one = g.contentHash();
+    g.set({ 10, 70 }, false);
+    g.set({ 70, 10 }, true);
+    CHECK(empty != one && one != g.contentHash());
+
+    // Blinker, block and a dying pair on a dead grid; a glider on a 32x32 torus
+    // comes back after 4 * 32 generations.
+    const auto periodOf = [](DynamicGrid grid, int history, int generations) -> std::optional<uint64_t> {
+        grid.setHashGenerations(true);
+        CycleDetector cycles(history);
+        cycles.add(0, grid.contentHash());
+        for (int i = 1; i <= generations; ++i) {
+            grid = evolve(grid, 1);
+            if (const std::optional<uint64_t> period = cycles.add(i, grid.contentHash())) {
+                return period;
+            }
+        }
+        return std::nullopt;
+    };
+    DynamicGrid blinker(40, 40);
+    for (int y = 10; y < 13; ++y) {
+        blinker.set({ 20, y }, true);
+    }
+    CHECK(periodOf(blinker, 8, 10) == 2);
+    blinker.set({ 30, 30 }, true);
+    blinker.set({ 30, 31 }, true);
+    blinker.set({ 31, 30 }, true);
+    blinker.set({ 31, 31 }, true);
+    CHECK(periodOf(blinker, 8, 10) == 2);
+    DynamicGrid pair(40, 40);
+    pair.set({ 5, 5 }, true);
+    pair.set({ 5, 6 }, true);
+    CHECK(periodOf(pair, 8, 10) == 1);
+    DynamicGrid glider(32, 32);
+    glider.setBoundary(Boundary::Torus);
+    for (const auto& c : { std::pair { 0, 1 }, std::pair { 1, 2 }, std::pair { 2, 0 }, std::pair { 2, 1 }, std::pair { 2, 2 } }) {
+        glider.set({ c.first, c.second }, true);
+    }
+    CHECK(!periodOf(glider, 64, 300));
+    CHECK(periodOf(glider, 200, 300) == 128);
+}
+
+// Fused stats against a cell-by-cell count: every SIMD level's kernel (with a
+// scalar remainder and a partial last word at width 1000), rules that birth
+// past the right edge (B0) or need the edge fix-ups, and the skipping of stable
+// words once a confined soup settles under ping-pong.
+void test_generation_stats()
+{
+    forEachSimdLevel([](SimdLevel level) {
+        for (const char* text : { "life", "B0/S8", "highlife" }) {
+            Rule rule;
+            CHECK(parseRule(text, rule));
+            const std::string label = std::string(simdLevelName(level)) + " / " + text;
+            checkCases(label.c_str(), ALL_BOUNDARIES, { { 1000, 20 } }, [&rule](Boundary b, const GridSizeCase& c) {
+                DynamicGrid soup = hashedSoup(c.width, c.height);
+                soup.setBoundary(b);
+                soup.setRule(rule);
+                soup.setCollectStats(true);
+                bool same = true;
+                for (int i = 0; i < 3 && same; ++i) {
+                    const DynamicGrid before = soup;
+                    soup = evolve(soup, 1);
+                    same = statsMatch(before, soup);
+                }
+                return same;
+            });
+        }
+    });
+
+    checkCases(nullptr, ALL_BOUNDARIES, { { 150, 120 }, { 1000, 40 }, { 130, 3 } }, [](Boundary b, const GridSizeCase& c) {
+        DynamicGrid a = confinedSoup(c, b);
+        DynamicGrid d(c.width, c.height);
+        DynamicGrid* cur = &a;
+        DynamicGrid* next = &d;
+        bool same = true;
+        // Turned on mid-run, once stable rows are being skipped.
+        for (int i = 0; i < 150 && same; ++i) {
+            cur->setCollectStats(i >= 40);
+            next->updateGrid(*cur);
+            same = i < 40 || statsMatch(*cur, *next);
+            std::swap(cur, next);
+        }
+        // Blocked steps count their last generation.
+        DynamicGrid blocked(c.width, c.height);
+        blocked.updateGrid(*cur, 5);
+        return same && statsMatch(evolve(*cur, 4), blocked);
+    });
+
+    // A glider crossing a quiet grid: the rows it leaves or enters change
+    // counts every generation while the blinker's are carried over.
+    DynamicGrid glider(200, 100);
+    glider.clear();
+    glider.setCollectStats(true);
+    setCells(glider, { { 10, 3 }, { 10, 4 }, { 10, 5 } });
+    setCells(glider, { { 0, 1 }, { 1, 2 }, { 2, 0 }, { 2, 1 }, { 2, 2 } });
+    DynamicGrid other(200, 100);
+    DynamicGrid* cur = &glider;
+    DynamicGrid* next = &other;
+    bool same = true;
+    for (int i = 0; i < 200 && same; ++i) {
+        next->updateGrid(*cur);
+        same = statsMatch(*cur, *next);
+        std::swap(cur, next);
+    }
+    CHECK(same);
+
+    DynamicGrid g(100, 10);
+    CHECK(g.population() == 0 && !g.stats());
+    setCells(g, { { 5, 10 }, { 5, 11 }, { 5, 12 } });
+    g.toggle({ 0, 0 });
+    g.toggle({ 0, 0 });
+    g.set({ 5, 10 }, true);
+    CHECK(g.population() == 3);
+    DynamicGrid h(100, 10);
+    h.updateGrid(g);
+    CHECK(h.population() == 3 && !h.stats()); // not collected: counted on demand
+    g.setCollectStats(true);
+    h.updateGrid(g);
+    CHECK(h.stats() && h.stats()->births == 2 && h.stats()->deaths == 2 && h.population() == 3);
+    h.toggle({ 9, 99 });
+    CHECK(h.population() == 4 && !h.stats());
+    h.clear();
+    CHECK(h.population() == 0);
+}
+
+// The bulk fill: the same seed gives the same grid at any thread count, the
+// density comes out as asked, and nothing lands past the right edge.
+void test_random_fill()
+{
+    DynamicGrid one(1000, 300);
+    one.setThreads(1);
+    one.randomize(0.3, 42);
+    bool same = true;
+    for (const int threads : { 2, 3, 7 }) {
+        DynamicGrid many(1000, 300);
+        many.setThreads(threads);
+        many.randomize(0.3, 42);
+        same = same && sameGrid(one, many) && many.population() == one.population();
+    }
+    CHECK(same);
+    CHECK(one.population() == aliveCount(one));
+    DynamicGrid other(1000, 300);
+    other.randomize(0.3, 43);
+    CHECK(!sameGrid(one, other));
+
+    // Within five standard deviations of the expected count.
+    bool near = true;
+    for (const double density : { 0.01, 0.25, 0.3, 0.5, 0.9 }) {
+        DynamicGrid g(1000, 300);
+        g.randomize(density, 7);
+        const double expected = density * 300000;
+        near = near && std::abs(static_cast<double>(g.population()) - expected) < 5 * std::sqrt(expected * (1 - density));
+    }
+    CHECK(near);
+
+    DynamicGrid full(100, 30);
+    full.randomize(1, 1);
+    CHECK(full.population() == 3000 && aliveCount(full) == 3000 && (full.row(29)[1] >> 36) == 0);
+    full.randomize(0, 1);
+    CHECK(full.population() == 0);
+
+    // Bits are independent and uniform: each of the 64 positions of a word is
+    // set about as often as the others.
+    DynamicGrid half(64, 4000);
+    half.randomize(0.5, 3);
+    int lo = 4000;
+    int hi = 0;
+    for (int y = 0; y < 64; ++y) {
+        int c = 0;
+        for (int x = 0; x < 4000; ++x) {
+            c += half.get({ x, y }) ? 1 : 0;
+        }
+        lo = std::min(lo, c);
+        hi = std::max(hi, c);
+    }
+    CHECK(lo > 1800 && hi < 2200);
+}
+
+// Every compiled rule, plus rules that only the generic kernel runs (including
+// B0 rules, which birth cells from empty space, and ones where 8 neighbors
+// differ from 0), against the reference on every SIMD level. The 1000-wide grid
+// exercises vector steps, the scalar remainder and the torus edge fix-up.
+void test_rules()
+{
+    std::vector<Rule> rules;
+    for (const NamedRule& named : NAMED_RULES) {
+        rules.push_back(named.rule);
+    }
+    for (const char* text : { "B0/S8", "B018/S1236", "B2/S0", "B45678/S2345678", "B/S" }) {
+        Rule rule;
+        CHECK(parseRule(text, rule) && ruleName(rule) == nullptr);
+        rules.push_back(rule);
+    }
+
+    forEachSimdLevel([&rules](SimdLevel level) {
+        for (const Rule& rule : rules) {
+            const std::string label = std::string(simdLevelName(level)) + " / " + ruleString(rule);
+            checkCases(label.c_str(), { Boundary::Dead, Boundary::Torus }, { { 1000, 20 } }, [&rule](Boundary b, const GridSizeCase& c) {
+                DynamicGrid soup = hashedSoup(c.width, c.height);
+                soup.setBoundary(b);
+                soup.setRule(rule);
+                bool same = true;
+                for (int i = 0; i < 4 && same; ++i) {
+                    const DynamicGrid expected = referenceStep(soup);
+                    soup = evolve(soup, 1);
+                    same = sameGrid(soup, expected) && soup.rule() == rule;
+                }
+                return same;
+            });
+        }
+    });
+
+    // HighLife's replicator copies itself: after 12 generations there are two.
+    DynamicGrid replicator(64, 64);
+    replicator.clear();
+    Rule highLife;
+    CHECK(parseRule("highlife", highLife));
+    replicator.setRule(highLife);
+    setCells(replicator, { { 30, 31 }, { 30, 32 }, { 30, 33 }, { 31, 30 }, { 31, 33 }, { 32, 29 }, { 32, 33 }, { 33, 29 }, { 33, 32 }, { 34, 29 }, { 34, 30 }, { 34, 31 } });
+    CHECK(aliveCount(evolve(replicator, 12)) == 24);
+
+    Rule parsed;
+    CHECK(parseRule("b36/s23", parsed) && parsed == highLife && ruleString(parsed) == "B36/S23");
+    CHECK(parseRule("B3S23", parsed) && parsed == Rule {});
+    CHECK(ruleString(Rule {}) == "B3/S23" && std::strcmp(ruleName(Rule {}), "life") == 0);
+    CHECK(!parseRule("B39/S23", parsed));
+    CHECK(!parseRule("B33/S23", parsed));
+    CHECK(!parseRule("S23/B3", parsed));
+    CHECK(!parseRule("B3/S23x", parsed));
+}
+
+// HashLife against the dense grid: a soup in the middle of a Dead-boundary grid
+// wide enough that nothing reaches its edges, stepped by counts that mix
+// power-of-two jumps (so the memoized results get invalidated and rebuilt).
+// Then the jump it exists for: a glider at generation 2^40 has moved 2^38 cells
+// diagonally and is still the same five cells, as is one that starts close to
+// the edge of its universe. A tiny memory budget forces
+// collections mid-step without changing the result.
+void test_hashlife()
+{
+    DynamicGrid seed(256, 256);
+    seed.clear();
+    const DynamicGrid soup = hashedSoup(64, 64);
+    for (int x = 0; x < 64; ++x) {
+        for (int y = 0; y < 64; ++y) {
+            seed.set({ 96 + x, 96 + y }, soup.get({ x, y }));
+        }
+    }
+
+    for (const Rule& rule : { Rule {}, NAMED_RULES[1].rule }) {
+        seed.setRule(rule);
+        HashLife life(rule);
+        life.fromGrid(seed);
+        DynamicGrid grid = seed;
+        DynamicGrid out(256, 256);
+        for (const int gens : { 1, 6, 37, 16 }) {
+            life.step(static_cast<uint64_t>(gens));
+            grid = evolve(grid, gens);
+            life.toGrid(out);
+            CHECK(sameGrid(out, grid));
+            CHECK(life.population() == static_cast<uint64_t>(aliveCount(grid)));
+        }
+        CHECK(life.generation() == 60);
+    }
+
+    HashLife glider;
+    for (const auto& c : { std::pair { 0, 1 }, std::pair { 1, 2 }, std::pair { 2, 0 }, std::pair { 2, 1 }, std::pair { 2, 2 } }) {
+        glider.set(c.first, c.second, true);
+    }
+    glider.step(uint64_t { 1 } << 40);
+    const int64_t shift = int64_t { 1 } << 38;
+    CHECK(glider.population() == 5);
+    CHECK(glider.get(shift, shift + 1) && glider.get(shift + 1, shift + 2) && glider.get(shift + 2, shift));
+    CHECK(glider.get(shift + 2, shift + 1) && glider.get(shift + 2, shift + 2) && !glider.get(0, 1));
+
+    // A glider heading out from near the root's edge, where a jump's margin is
+    // thinnest: nothing may be clipped on the way.
+    bool kept = true;
+    for (const auto& [size, at, gens] : { std::tuple { 1024, 500, 64 }, std::tuple { 64, 58, 13 }, std::tuple { 64, 58, 40 } }) {
+        DynamicGrid start(size, size);
+        DynamicGrid grid(2 * size, 2 * size);
+        start.clear();
+        grid.clear();
+        for (const auto& c : { std::pair { 0, 1 }, std::pair { 1, 2 }, std::pair { 2, 0 }, std::pair { 2, 1 }, std::pair { 2, 2 } }) {
+            start.set({ at + c.first, at + c.second }, true);
+            grid.set({ at + c.first, at + c.second }, true);
+        }
+        HashLife life;
+        life.fromGrid(start);
+        life.step(static_cast<uint64_t>(gens));
+        grid = evolve(grid, gens);
+        DynamicGrid out(2 * size, 2 * size);
+        life.toGrid(out);
+        kept = kept && life.population() == 5 && sameGrid(out, grid);
+    }
+    CHECK(kept);
+
+    HashLife big;
+    HashLife small(Rule {}, 256 << 10);
+    big.fromGrid(seed);
+    small.fromGrid(seed);
+    big.step(300);
+    small.step(300);
+    DynamicGrid a(768, 768);
+    DynamicGrid b(768, 768);
+    big.toGrid(a, -256, -256);
+    small.toGrid(b, -256, -256);
+    CHECK(sameGrid(a, b) && static_cast<uint64_t>(aliveCount(a)) == big.population());
+    CHECK(small.collections() > 0 && big.collections() == 0);
+    CHECK(small.memoryUsage() <= small.memoryBudget());
+
+    bool threw = false;
+    try {
+        HashLife b0(Rule { 1, 0 });
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    CHECK(threw);
+}
+
+// The tiled engine against the dense grid on a soup whose debris crosses tile
+// edges and corners, then the case it is for: two gliders a billion cells apart
+// only ever touch a few tiles, cells past 32-bit tile coordinates keep their
+// own tiles, and a pattern that dies leaves no tiles behind.
+void test_sparse_life()
+{
+    DynamicGrid seed(256, 256);
+    seed.clear();
+    const DynamicGrid soup = hashedSoup(70, 70);
+    for (int x = 0; x < 70; ++x) {
+        for (int y = 0; y < 70; ++y) {
+            seed.set({ 93 + x, 93 + y }, soup.get({ x, y }));
+        }
+    }
+    for (const Rule& rule : { Rule {}, NAMED_RULES[1].rule, Rule { 0b1000, 0b100001100 } }) {
+        seed.setRule(rule);
+        SparseLife life(rule);
+        life.fromGrid(seed);
+        DynamicGrid grid = seed;
+        DynamicGrid out(256, 256);
+        bool same = true;
+        for (int i = 0; i < 40 && same; ++i) {
+            life.step();
+            grid = evolve(grid, 1);
+            life.toGrid(out);
+            same = sameGrid(out, grid) && life.population() == static_cast<uint64_t>(aliveCount(grid));
+        }
+        CHECK(same);
+        CHECK(life.generation() == 40);
+    }
+
+    SparseLife gliders;
+    const int64_t far = 1'000'000'000;
+    for (const int64_t o : { int64_t { -far }, far }) {
+        for (const auto& c : { std::pair { 0, 1 }, std::pair { 1, 2 }, std::pair { 2, 0 }, std::pair { 2, 1 }, std::pair { 2, 2 } }) {
+            gliders.set(o + c.first, o + c.second, true);
+        }
+    }
+    gliders.step(400);
+    CHECK(gliders.population() == 10);
+    CHECK(gliders.get(far + 100, far + 101) && gliders.get(-far + 102, -far + 102));
+    CHECK(gliders.tileCount() <= 8 && gliders.steppedTiles() <= 18);
+
+    // Tiles 2^34 apart in both directions stay apart.
+    SparseLife blocks;
+    const int64_t huge = int64_t { 1 } << 40;
+    for (const int64_t o : { int64_t { 0 }, huge, -huge }) {
+        blocks.set(o + 10, o + 10, true);
+        blocks.set(o + 10, o + 11, true);
+        blocks.set(o + 11, o + 10, true);
+    }
+    CHECK(blocks.tileCount() == 3 && blocks.get(huge + 10, huge + 10) && !blocks.get(huge + 11, 11));
+    blocks.step(2);
+    CHECK(blocks.population() == 12 && blocks.get(-huge + 11, -huge + 11) && blocks.get(11, 11));
+
+    SparseLife dying;
+    dying.set(63, 63, true);
+    dying.set(64, 64, true);
+    dying.step(2);
+    CHECK(dying.population() == 0 && dying.tileCount() == 0);
+}
+
 struct Test {
     const char* name;
     void (*fn)();
@@ -372,6 +1768,31 @@ const Test kTests[] = {
     { "birth/death rules", test_birth_and_death_rules },
     { "non-toroidal edges", test_non_toroidal_edges },
     { "parallel determinism", test_parallel_determinism },
+    { "SIMD kernels", test_simd_kernels },
+    { "runtime-sized grid", test_dynamic_grid },
+    { "rectangular grid", test_rectangular_grid },
+    { "boundary modes", test_boundary_modes },
+    { "neighbor planes", test_neighbor_planes },
+    { "pixel rendering", test_render },
+    { "render/update overlap", test_render_overlap },
+    { "triple buffer", test_triple_buffer },
+    { "band executor", test_band_executor },
+    { "schedules", test_schedules },
+    { "thread affinity", test_affinity },
+    { "thread tuning", test_tuner },
+    { "batch universes", test_batch_life },
+    { "band stats", test_band_stats },
+    { "pattern files", test_pattern_io },
+    { "checkpoints", test_checkpoint },
+    { "recordings", test_recording },
+    { "Life-like rules", test_rules },
+    { "HashLife", test_hashlife },
+    { "sparse tiles", test_sparse_life },
+    { "temporal blocking", test_temporal_blocking },
+    { "activity tracking", test_activity_tracking },
+    { "generation stats", test_generation_stats },
+    { "cycle detection", test_cycle_detection },
+    { "random fill", test_random_fill },
 };
 
 } // namespace